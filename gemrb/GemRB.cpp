@@ -29,6 +29,53 @@
 
 using namespace GemRB;
 
+#ifdef GEMRB_BENCHMARK
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// count every heap allocation, so the benchmark can report them
+static std::atomic<uint64_t> allocations { 0 };
+
+static uint64_t CountAllocations()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	void* ptr = malloc(size ? size : 1);
+	if (!ptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+#endif
+
 int main(int argc, char* argv[])
 {
 	setlocale(LC_ALL, "");
@@ -64,6 +111,9 @@ int main(int argc, char* argv[])
 		SanityCheck();
 
 		Interface gemrb(std::move(cfg));
+#ifdef GEMRB_BENCHMARK
+		gemrb.AllocationCounter = CountAllocations;
+#endif
 		gemrb.Main();
 	} catch (CoreInitializationException& cie) {
 		Log(FATAL, "Main", "Aborting due to fatal error... {}", cie);
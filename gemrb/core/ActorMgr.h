@@ -32,6 +32,11 @@ class Actor;
 class GEM_EXPORT ActorMgr : public ImporterBase {
 public:
 	virtual Actor* GetActor(unsigned char is_in_party) = 0;
+	/** Parses the creature without the parts rolled for each instance, see CopyActor */
+	virtual Actor* GetActorTemplate() = 0;
+	/** A new actor from a template returned by GetActorTemplate of this importer,
+	 * with its own random colours, equipped weapon and load time setup */
+	virtual Actor* CopyActor(const Actor& actorTemplate) = 0;
 	virtual ieWord FindSpellType(const ResRef& name, unsigned short &level, unsigned int clsMask, unsigned int kit) const = 0;
 
 	//returns saved size, updates internal offsets before save
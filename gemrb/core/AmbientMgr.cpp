@@ -182,6 +182,7 @@ void AmbientMgr::HardStop() const
 
 int AmbientMgr::Play()
 {
+	TRACY(tracy::SetThreadName("Ambients"));
 	while (playing) {
 		std::unique_lock<std::recursive_mutex> l(mutex);
 		tick_t time = GetMilliseconds();
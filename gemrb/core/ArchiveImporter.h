@@ -33,7 +33,7 @@ public:
 	virtual int CreateArchive(DataStream *stream) = 0;
 	//decompressing a .sav file similar to CBF
 	virtual int DecompressSaveGame(DataStream *compressed, SaveGameAREExtractor&) = 0;
-	virtual int AddToSaveGame(DataStream *str, DataStream *uncompressed) = 0;
+	virtual int AddToSaveGame(DataStream *str, DataStream *uncompressed, int level) = 0;
 	virtual int AddToSaveGameCompressed(DataStream *str, DataStream *compressed) = 0;
 };
 
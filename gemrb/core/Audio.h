@@ -130,6 +130,9 @@ public:
 	Holder<SoundHandle> Play(StringView ResRef, SFXChannel channel, tick_t* length = nullptr)
 			{ return Play(ResRef, channel, Point(), 0, length); }
 	
+	/** Decodes a sound in the background, so a later Play of it doesn't have to wait */
+	virtual void Prefetch(StringView /*ResRef*/) {}
+
 	virtual AmbientMgr* GetAmbientMgr() { return ambim; }
 	virtual void UpdateVolume(unsigned int flags = GEM_SND_VOL_MUSIC | GEM_SND_VOL_AMBIENTS) = 0;
 	virtual bool CanPlay() = 0;
@@ -27,6 +27,7 @@
 
 #include "globals.h"
 #include "ie_types.h"
+#include "Profiler.h"
 
 namespace GemRB {
 
@@ -55,6 +56,7 @@ class RCCache {
 			auto lookup = map.find(key);
 			if (lookup != map.cend()) {
 				lookup->second.refCount++;
+				Profiler::Count(ProfileCounter::CacheHits);
 
 				return &lookup->second.value;
 			}
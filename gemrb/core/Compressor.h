@@ -30,8 +30,9 @@ class GEM_EXPORT Compressor : public Plugin {
 public:
 	/** decompresses a datastream (memory or file) to a FILE * stream */
 	virtual int Decompress(DataStream* dest, DataStream* source, unsigned int size_guess = 0) const = 0;
-	/** compresses a datastream (memory or file) to another DataStream */
-	virtual int Compress(DataStream *dest, DataStream* source) const = 0;
+	/** compresses a datastream (memory or file) to another DataStream,
+	 *  level goes from 0 (just store the data) to 9 (smallest output) */
+	virtual int Compress(DataStream *dest, DataStream* source, int level = 9) const = 0;
 };
 
 }
@@ -49,12 +49,14 @@ EnumArray<FogRenderer::Direction, Holder<Sprite2D>> FogRenderer::LoadFogSprites(
 	return sprites;
 }
 
-FogRenderer::FogRenderer(bool doBAMRendering) :
+FogRenderer::FogRenderer(bool doBAMRendering, bool retainedRendering) :
 	videoCanRenderGeometry(!doBAMRendering && VideoDriver->CanDrawRawGeometry()),
 	fogVertices(24),
 	fogColors(12)
 {
 	fogSprites = LoadFogSprites();
+	// the mesh needs per vertex colors, so there is no sprite fallback
+	retained = retainedRendering && videoCanRenderGeometry;
 }
 
 void FogRenderer::DrawFog(const FogMapData& mapData) {
@@ -74,6 +76,139 @@ void FogRenderer::DrawFog(const FogMapData& mapData) {
 
 	DrawVPBorders();
 
+	if (retained) {
+		DrawRetainedFog(mapData);
+	} else {
+		DrawCellFog(mapData);
+	}
+}
+
+void FogRenderer::DrawRetainedFog(const FogMapData& mapData) {
+	if (UpdateCellAlpha(mapData) || meshViewport != vp) {
+		meshViewport = vp;
+		meshDirty = true;
+	}
+
+	if (meshDirty) {
+		RebuildMesh();
+		meshDirty = false;
+	}
+
+	if (!meshVertices.empty()) {
+		VideoDriver->DrawRawGeometry(meshVertices, meshColors, BlitFlags::BLENDED);
+	}
+}
+
+// syncs cellAlpha with the masks, only recomputing the cells of changed bytes
+// returns true if anything changed
+bool FogRenderer::UpdateCellAlpha(const FogMapData& mapData) {
+	bool fullUpdate = false;
+	if (cellsSize != mapData.fogSize) {
+		cellsSize = mapData.fogSize;
+		cellAlpha.assign(cellsSize.w * cellsSize.h, 0);
+		fullUpdate = true;
+	}
+
+	std::vector<bool> dirtyBytes;
+	const Bitmap* masks[2] = { mapData.exploredMask, mapData.visibleMask };
+	for (int i = 0; i < 2; ++i) {
+		const Bitmap* mask = masks[i];
+		if ((mask == nullptr) != maskWasNull[i]) {
+			maskWasNull[i] = mask == nullptr;
+			fullUpdate = true;
+		}
+		if (!mask) {
+			maskCopies[i].clear();
+			continue;
+		}
+
+		const uint8_t* bits = mask->begin();
+		auto& copy = maskCopies[i];
+		if (copy.size() != size_t(mask->Bytes())) {
+			copy.assign(bits, bits + mask->Bytes());
+			fullUpdate = true;
+			continue;
+		}
+		if (fullUpdate || std::equal(copy.begin(), copy.end(), bits)) {
+			std::copy(bits, bits + mask->Bytes(), copy.begin());
+			continue;
+		}
+
+		dirtyBytes.resize(copy.size());
+		for (size_t b = 0; b < copy.size(); ++b) {
+			if (copy[b] != bits[b]) {
+				copy[b] = bits[b];
+				dirtyBytes[b] = true;
+			}
+		}
+	}
+
+	if (fullUpdate) {
+		for (int y = 0; y < cellsSize.h; ++y) {
+			for (int x = 0; x < cellsSize.w; ++x) {
+				cellAlpha[y * cellsSize.w + x] = GetCellAlpha(Point(x, y));
+			}
+		}
+		return true;
+	}
+
+	bool changed = false;
+	for (size_t b = 0; b < dirtyBytes.size(); ++b) {
+		if (!dirtyBytes[b]) continue;
+		int first = int(b) * 8;
+		int last = std::min(first + 8, cellsSize.w * cellsSize.h);
+		for (int idx = first; idx < last; ++idx) {
+			cellAlpha[idx] = GetCellAlpha(Point(idx % cellsSize.w, idx / cellsSize.w));
+		}
+		changed = true;
+	}
+	return changed;
+}
+
+uint8_t FogRenderer::GetCellAlpha(Point cell) const {
+	auto IsSet = [&cell, this](int i) {
+		if (maskWasNull[i]) return true;
+		if (!Region(Point(), cellsSize).PointInside(cell)) return false;
+		int idx = cell.y * cellsSize.w + cell.x;
+		return bool(maskCopies[i][idx / 8] & (1 << (idx % 8)));
+	};
+
+	if (!IsSet(0)) return 255; // unexplored
+	if (!IsSet(1)) return 128; // shrouded, matches TRANSPARENT_FOG
+	return 0;
+}
+
+void FogRenderer::RebuildMesh() {
+	meshVertices.clear();
+	meshColors.clear();
+
+	auto AlphaAt = [this](int x, int y) -> uint8_t {
+		if (x < 0 || y < 0 || x >= cellsSize.w || y >= cellsSize.h) return 255;
+		return cellAlpha[y * cellsSize.w + x];
+	};
+
+	// one vertex per cell center, starting a cell early, so the whole viewport is covered
+	for (int y = start.y - 1; y < end.y - 1; ++y) {
+		for (int x = start.x - 1; x < end.x - 1; ++x) {
+			uint8_t a[4] = { AlphaAt(x, y), AlphaAt(x + 1, y), AlphaAt(x, y + 1), AlphaAt(x + 1, y + 1) };
+			if ((a[0] | a[1] | a[2] | a[3]) == 0) {
+				continue; // fully visible
+			}
+
+			Point sp = ConvertPointToScreen(x, y) + Point(CELL_SIZE / 2, CELL_SIZE / 2);
+			const float px[4] = { float(sp.x), float(sp.x + CELL_SIZE), float(sp.x), float(sp.x + CELL_SIZE) };
+			const float py[4] = { float(sp.y), float(sp.y), float(sp.y + CELL_SIZE), float(sp.y + CELL_SIZE) };
+			// two triangles: top left, top right, bottom left and bottom left, top right, bottom right
+			for (int corner : { 0, 1, 2, 2, 1, 3 }) {
+				meshVertices.push_back(px[corner]);
+				meshVertices.push_back(py[corner]);
+				meshColors.emplace_back(0, 0, 0, a[corner]);
+			}
+		}
+	}
+}
+
+void FogRenderer::DrawCellFog(const FogMapData& mapData) {
 	for (int y = start.y; y < end.y; y++) {
 		int unexploredQueue = 0;
 		int shroudedQueue = 0;
@@ -96,14 +96,32 @@ class GEM_EXPORT FogRenderer {
 	
 		static EnumArray<Direction, Holder<Sprite2D>> LoadFogSprites();
 		EnumArray<Direction, Holder<Sprite2D>> fogSprites;
+
+		// retained mode: one alpha value per fog cell, kept in sync with the masks and
+		// drawn as a single mesh through the cell centers, so the interpolation does the smoothing
+		bool retained = false;
+		Size cellsSize;
+		bool maskWasNull[2] { false, false };
+		std::vector<uint8_t> maskCopies[2];
+		std::vector<uint8_t> cellAlpha;
+		std::vector<float> meshVertices;
+		std::vector<Color> meshColors;
+		Region meshViewport;
+		bool meshDirty = true;
+
 	public:
-		explicit FogRenderer(bool doBAMRendering = false);
+		explicit FogRenderer(bool doBAMRendering = false, bool retainedRendering = false);
 
 		void DrawFog(const FogMapData& mapData);
 
 	private:
 		Point ConvertPointToScreen(int x, int y) const;
 		static Point ConvertPointToFog(Point p);
+		void DrawCellFog(const FogMapData& mapData);
+		void DrawRetainedFog(const FogMapData& mapData);
+		bool UpdateCellAlpha(const FogMapData& mapData);
+		uint8_t GetCellAlpha(Point cellPoint) const;
+		void RebuildMesh();
 		void DrawExploredCell(Point cellPoint, const Bitmap *mask);
 		void DrawFogCellBAM(Point p, Direction direction, BlitFlags flags);
 		void DrawFogCellVertices(Point p, Direction direction, BlitFlags flags);
@@ -75,7 +75,7 @@ private:
 	int lastCursor = 0;
 	Point vpVector;
 	int numScrollCursor = 0;
-	PathListNode* drawPath = nullptr;
+	Path drawPath;
 	EnumBitset<ScreenFlags> screenFlags { ScreenFlags::CenterOnActor };
 	unsigned int DialogueFlags = DF_FREEZE_SCRIPTS;
 	String DisplayText;
@@ -21,6 +21,7 @@
 #include "Debug.h"
 #include "Interface.h"
 #include "Palette.h"
+#include "Profiler.h"
 #include "Sprite2D.h"
 #include "Strings/String.h"
 #include "Video/Video.h"
@@ -361,14 +362,20 @@ void ContentContainer::DrawSelf(const Region& drawFrame, const Region& clip)
 
 	// layout shouldn't be empty unless there is no content anyway...
 	if (layout.empty()) return;
-	Point dp = drawFrame.origin + Point(margin.left, margin.top);
-	
-	ContentLayout::const_iterator it = layout.begin();
-	for (; it != layout.end(); ++it) {
-		const Layout& l = *it;
+	Point dp = drawFrame.origin + Point(margin.left, margin.top - layoutOffset);
+
+	if (!CullsContents()) {
+		for (const Layout& l : layout) {
+			DrawContents(l, dp);
+		}
+		return;
+	}
 
-		// TODO: pass the clip rect so we can skip non-intersecting regions
-		DrawContents(l, dp);
+	// only draw what intersects the clip, long histories are mostly scrolled out of view
+	int clipBottom = clip.y + clip.h - dp.y;
+	ContentLayout::const_iterator it = FirstLayoutBelow(clip.y - dp.y);
+	for (; it != layout.end() && it->bounds.y < clipBottom; ++it) {
+		DrawContents(*it, dp);
 	}
 }
 
@@ -437,7 +444,7 @@ Content* ContentContainer::RemoveContent(const Content* span, bool doLayout)
 		content->parent = NULL;
 		layout.erase(std::find(layout.begin(), layout.end(), content));
 
-		layoutPoint.reset(); // reset cached layoutPoint
+		layoutPoint = Point(0, layoutOffset); // reset cached layoutPoint
 		if (doLayout) {
 			LayoutContentsFrom(it);
 		}
@@ -454,7 +461,7 @@ ContentContainer::EraseContent(ContentList::iterator it)
 	Content* content = *it;
 	content->parent = NULL;
 	layout.erase(std::find(layout.begin(), layout.end(), content));
-	layoutPoint.reset(); // reset cached layoutPoint
+	layoutPoint = Point(0, layoutOffset); // reset cached layoutPoint
 	ContentRemoved(content);
 	delete content;
 
@@ -472,7 +479,7 @@ ContentContainer::EraseContent(ContentList::iterator beg, ContentList::iterator
 
 Content* ContentContainer::ContentAtPoint(const Point& p) const
 {
-	const Layout* contentLayout = LayoutAtPoint(p);
+	const Layout* contentLayout = LayoutAtPoint(p + Point(0, layoutOffset));
 	if (contentLayout) {
 		// i know we are casting away const.
 		// we could return std::find(contents.begin(), contents.end(), *it) instead, but whats the point?
@@ -522,6 +529,7 @@ Region ContentContainer::BoundingBoxForLayout(const LayoutRegions& layoutRgns) c
 		for (; it != layoutRgns.end(); ++it) {
 			r.ExpandToRegion((*it)->region);
 		}
+		r.y -= layoutOffset;
 		return r;
 	}
 	
@@ -530,18 +538,37 @@ Region ContentContainer::BoundingBoxForLayout(const LayoutRegions& layoutRgns) c
 
 const ContentContainer::Layout& ContentContainer::LayoutForContent(const Content* c) const
 {
-	ContentLayout::const_iterator it = std::find(layout.begin(), layout.end(), c);
-	if (it != layout.end()) {
+	// search from the back, since that is where appending happens
+	auto it = std::find(layout.rbegin(), layout.rend(), c);
+	if (it != layout.rend()) {
 		return *it;
 	}
 	static Layout NullLayout(nullptr, LayoutRegions());
 	return NullLayout;
 }
 
+ContentContainer::ContentLayout::const_iterator ContentContainer::FirstLayoutBelow(int y) const
+{
+	return std::partition_point(layout.begin(), layout.end(), [y](const Layout& l) {
+		return l.maxBottom <= y;
+	});
+}
+
+void ContentContainer::AddLayout(const Content* content, LayoutRegions rgns)
+{
+	int prevBottom = layout.empty() ? 0 : layout.back().maxBottom;
+	layout.emplace_back(content, std::move(rgns));
+	Layout& added = layout.back();
+	added.maxBottom = std::max(added.maxBottom, prevBottom);
+}
+
 const Region* ContentContainer::ContentRegionForRect(const Region& r) const
 {
-	for (const auto& layoutRgn : layout) {
-		for (const auto& lrgn : layoutRgn.regions) {
+	// layouts are ordered ttb, so we can skip everything above the rect and stop below it
+	int bottom = r.y + r.h;
+	ContentLayout::const_iterator it = FirstLayoutBelow(r.y);
+	for (; it != layout.end() && it->bounds.y < bottom; ++it) {
+		for (const auto& lrgn : it->regions) {
 			const Region& rect = lrgn->region;
 			if (rect.IntersectsRegion(r)) {
 				return &rect;
@@ -561,6 +588,7 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 	if (it == contents.end()) {
 		return; // must bail or things will get screwed up!
 	}
+	PROFILE_ZONE(TextLayout);
 
 	const Content* exContent = NULL;
 	const Region* excluded = NULL;
@@ -572,19 +600,29 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 	}
 
 	// clear the existing layout, but only for "it" and onward
+	// when appending there is nothing to clear and only the new content gets measured
 	ContentList::const_iterator clearit = it;
+	if (!layout.empty() && layout.back().content == exContent) {
+		clearit = contents.end();
+	}
 	for (; clearit != contents.end(); ++clearit) {
 		ContentLayout::iterator i = std::find(layout.begin(), layout.end(), *clearit);
 		if (i != layout.end()) {
-			layoutPoint.reset(); // reset cached layoutPoint
+			layoutPoint = Point(0, layoutOffset); // reset cached layoutPoint
 			// since 'layout' is sorted alongsize 'contents' we should be able clear everything following 'i' and bail
 			layout.erase(i, layout.end());
 			break;
 		}
 	}
+	if (layout.empty()) {
+		// starting over, so there is nothing left to offset
+		layoutOffset = 0;
+		layoutPoint = Point();
+	}
 
 	Size contentBounds = Dimensions();
-	Region layoutFrame = Region(Point(), contentBounds);
+	// contents lay out relative to the frame, so this puts their regions in layout coordinates
+	Region layoutFrame = Region(Point(0, layoutOffset), contentBounds);
 	if (Flags()&RESIZE_WIDTH) {
 		layoutFrame.w = SHRT_MAX;
 	} else {
@@ -617,12 +655,13 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 					layoutPoint.y = excluded->y + excluded->h;
 				}
 			}
-			exContent = ContentAtPoint(layoutPoint);
+			const Layout* exLayout = LayoutAtPoint(layoutPoint);
+			exContent = exLayout ? exLayout->content : nullptr;
 			assert(exContent != content);
 		}
-		const LayoutRegions& rgns = content->LayoutForPointInRegion(layoutPoint, layoutFrame);
+		const LayoutRegions& rgns = content->LayoutForPointInRegion(layoutPoint - Point(0, layoutOffset), layoutFrame);
 		if (rgns.empty()) return;
-		layout.emplace_back(content, rgns);
+		AddLayout(content, rgns);
 		exContent = content;
 
 		ieDword flags = Flags();
@@ -647,26 +686,47 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 
 void ContentContainer::DeleteContentsInRect(const Region& exclusion)
 {
-	int top = exclusion.y;
+	Region layoutExclusion = exclusion;
+	layoutExclusion.y += layoutOffset;
+	int top = layoutExclusion.y;
 	int bottom = top;
 	const Content* content;
-	while (const Region* rgn = ContentRegionForRect(exclusion)) {
-		content = ContentAtPoint(rgn->origin);
-		assert(content);
-
+	// trimming the head of a history only removes layouts from the front
+	bool frontOnly = true;
+	Point oldLayoutPoint = layoutPoint;
+	while (const Region* rgn = ContentRegionForRect(layoutExclusion)) {
+		const Layout* contentLayout = LayoutAtPoint(rgn->origin);
+		assert(contentLayout);
+		content = contentLayout->content;
+
+		frontOnly = frontOnly && layout.front().content == content;
 		top = (rgn->y < top) ? rgn->y : top;
 		bottom = (rgn->y + rgn->h > bottom) ? rgn->y + rgn->h : bottom;
 		// must delete content last!
 		delete RemoveContent(content, false);
 	}
 
+	// if what remains starts on a fresh line, wrapping cannot change
+	// and the old layout is still good once moved up
+	if (frontOnly && !layout.empty() && layout.front().regions.front()->region.x == 0 && !(Flags() & RESIZE_WIDTH)) {
+		layoutOffset = layout.front().bounds.y;
+		// the cached layoutPoint is only still valid if it wasn't in the removed content
+		layoutPoint = oldLayoutPoint.y >= layoutOffset ? oldLayoutPoint : Point(0, layoutOffset);
+
+		Size oldSize = Dimensions();
+		if (Flags() & RESIZE_HEIGHT) {
+			frame.h = layout.back().maxBottom - layoutOffset + margin.top + margin.bottom;
+		}
+		ResizeSubviews(oldSize);
+		return;
+	}
+
 	if (Flags()&RESIZE_HEIGHT) {
 		frame.h = 0;
 	}
 	if (Flags()&RESIZE_WIDTH) {
 		frame.w = 0;
 	}
-	// TODO: we could optimize this to only layout content after exclusion.y
 	LayoutContentsFrom(contents.begin());
 }
 
@@ -814,7 +874,8 @@ void TextContainer::MoveCursorToPoint(const Point& p)
 	if (Editable() == false)
 		return;
 
-	const Layout* layout = LayoutAtPoint(p);
+	Point lp = p + Point(0, layoutOffset);
+	const Layout* layout = LayoutAtPoint(lp);
 
 	if (layout) {
 		const TextSpan* ts = (const TextSpan*) layout->content;
@@ -826,9 +887,9 @@ void TextContainer::MoveCursorToPoint(const Point& p)
 		for (const auto& lrgn : layout->regions) {
 			const Region& rect = lrgn->region;
 
-			if (rect.PointInside(p)) {
+			if (rect.PointInside(lp)) {
 				// find where inside
-				int lines = (p.y - rect.y) / printFont->LineHeight;
+				int lines = (lp.y - rect.y) / printFont->LineHeight;
 				if (lines) {
 					metrics.size.w = rect.w;
 					metrics.size.h = lines * printFont->LineHeight;
@@ -157,10 +157,19 @@ protected:
 	struct Layout {
 		const Content* content;
 		LayoutRegions regions;
+		// cached bounding box of regions
+		Region bounds;
+		// the lowest bottom edge of this and all preceding layouts, so we can binary search by y
+		int maxBottom = 0;
 		
 		Layout(const Content* c, LayoutRegions rgns)
 		: content(c), regions(std::move(rgns)) {
 			assert(!regions.empty());
+			bounds = regions.front()->region;
+			for (const auto& layoutRegion : regions) {
+				bounds.ExpandToRegion(layoutRegion->region);
+			}
+			maxBottom = bounds.y + bounds.h;
 		}
 
 		bool operator==(const Content* c) const {
@@ -184,8 +193,11 @@ protected:
 	};
 
 	using ContentLayout = std::deque<Layout>;
+	// the regions are kept in layout coordinates, which are ours offset by layoutOffset
 	ContentLayout layout;
-	Point layoutPoint;
+	Point layoutPoint; // in layout coordinates
+	// trimming the head of a history only raises this, so the remaining regions need no update
+	int layoutOffset = 0;
 
 	Margin margin;
 
@@ -205,6 +217,7 @@ public:
 	Content* ContentAtPoint(const Point& p) const;
 	const ContentList& Contents() const { return contents; }
 
+	// rect is in layout coordinates, like the returned region
 	const Region* ContentRegionForRect(const Region& rect) const;
 	Region BoundingBoxForContent(const Content*) const;
 	Region BoundingBoxForLayout(const LayoutRegions&) const;
@@ -225,6 +238,9 @@ protected:
 
 	const Layout& LayoutForContent(const Content*) const;
 	const Layout* LayoutAtPoint(const Point& p) const;
+	// first layout that reaches below y (in layout coordinates)
+	ContentLayout::const_iterator FirstLayoutBelow(int y) const;
+	void AddLayout(const Content* content, LayoutRegions rgns);
 
 	void DrawSelf(const Region& drawFrame, const Region& clip) override;
 	virtual void DrawContents(const Layout& contentLayout, Point point);
@@ -233,6 +249,8 @@ protected:
 
 private:
 	virtual void ContentRemoved(const Content* /*content*/) {};
+	// whether DrawSelf may skip the layouts outside the clip
+	virtual bool CullsContents() const { return true; }
 	
 	void WillDraw(const Region& /*drawFrame*/, const Region& /*clip*/) override;
 	void DidDraw(const Region& /*drawFrame*/, const Region& /*clip*/) override;
@@ -264,6 +282,8 @@ private:
 	void DrawContents(const Layout& layout, Point point) override;
 
 	virtual bool Editable() const { return IsReceivingEvents(); }
+	// cursor drawing needs to count every character before it
+	bool CullsContents() const override { return !Editable(); }
 	void SizeChanged(const Size& oldSize) override;
 
 	using ContentIndex = std::pair<size_t, ContentList::iterator>;
@@ -22,6 +22,7 @@
 #include "GameData.h"
 #include "Interface.h"
 #include "ImageMgr.h"
+#include "Profiler.h"
 #include "Tooltip.h"
 #include "Window.h"
 #include "GUI/GameControl.h"
@@ -599,7 +600,7 @@ WindowManager::HUDLock WindowManager::DrawHUD() const
 
 void WindowManager::DrawWindows() const
 {
-	TRACY(ZoneScoped);
+	PROFILE_ZONE(Drawing);
 	HUDBuf->Clear();
 
 	if (windows.empty()) {
@@ -132,6 +132,7 @@ Game::Game(void) : Scriptable( ST_GLOBAL )
 
 Game::~Game(void)
 {
+	InvalidateVariableRefs();
 	delete weather;
 	for (auto map : Maps) {
 		delete map;
@@ -679,6 +680,7 @@ Map* Game::GetMap(const ResRef& areaName, bool change)
 
 	MapIndex = index;
 	area = GetMap(index);
+	area->LastVisit = GameTime;
 	CurrentArea = areaName;
 	if (area->MasterArea) LastMasterArea = areaName;
 	// change the tileset if needed
@@ -742,8 +744,7 @@ int Game::DelMap(unsigned int index, int forced)
 	}
 
 	// this was not used in the originals and may be in the wrong place
-	// (definitely if MAX_MAPS_LOADED gets bumped)
-	if (map->INISpawn) map->INISpawn->ExitSpawn();
+	if (map->INISpawn && !map->Dormant) map->INISpawn->ExitSpawn();
 
 	if (!forced && Maps.size() <= MAX_MAPS_LOADED) {
 		// not removing the map
@@ -774,24 +775,38 @@ int Game::DelMap(unsigned int index, int forced)
 		}
 	}
 
-	// one last script execution, so the Vacant trigger is more likely to run (pst ar0109)
-	if (core->HasFeature(GFFlags::PST_STATE_FLAGS)) {
-		map->ExecuteScript(MAX_SCRIPTS);
-		map->ProcessActions();
-	}
-
-	map->PurgeArea(false);
-
 	// if there are still selected actors on the map (e.g. summons)
 	// unselect them now before they get axed
 	for (auto m = selected.begin(); m != selected.end();) {
-		if (!(*m)->InParty && (*m)->AreaName == Maps[index]->GetScriptRef()) {
+		if (!(*m)->InParty && (*m)->AreaName == map->GetScriptRef()) {
 			m = selected.erase(m);
 		} else {
 			++m;
 		}
 	}
 
+	// dormant maps already went through this when the party left
+	if (!map->Dormant) {
+		// one last script execution, so the Vacant trigger is more likely to run (pst ar0109)
+		if (core->HasFeature(GFFlags::PST_STATE_FLAGS)) {
+			map->ExecuteScript(MAX_SCRIPTS);
+			map->ProcessActions();
+		}
+
+		map->PurgeArea(false);
+	}
+
+	// keep recently visited areas in memory, so walking back doesn't need a full
+	// save and reload; they stay frozen until then and EvictDormantMaps enforces the budget
+	if (!forced && core->config.AreaCacheSize > 0) {
+		// PurgeArea detached the remaining actors, but they stay with the map
+		map->SetInternalFlag(IF_JUSTDIED, BitOp::NAND);
+		map->InitActors();
+		map->Dormant = true;
+		map->DormantFootprint = map->ResidentFootprint();
+		return 0;
+	}
+
 	// remove map from memory
 	core->SwapoutArea(Maps[index]);
 	delete Maps[index];
@@ -803,6 +818,57 @@ int Game::DelMap(unsigned int index, int forced)
 	return 1;
 }
 
+void Game::EvictDormantMaps()
+{
+	size_t budget = size_t(core->config.AreaCacheSize) * 1024 * 1024;
+	while (true) {
+		size_t used = 0;
+		int oldest = -1;
+		for (size_t i = 0; i < Maps.size(); ++i) {
+			const Map* map = Maps[i];
+			if (!map->Dormant) continue;
+			used += map->DormantFootprint;
+			if (oldest < 0 || map->LastVisit < Maps[oldest]->LastVisit) {
+				oldest = int(i);
+			}
+		}
+		if (oldest < 0 || used <= budget) {
+			return;
+		}
+
+		size_t count = Maps.size();
+		DelMap(oldest, 1);
+		if (Maps.size() == count) {
+			// something still needs it, so let it run again
+			Maps[oldest]->Dormant = false;
+			return;
+		}
+	}
+}
+
+// redoes the parts of LoadMap that happen on each entry, since a dormant map skipped them
+void Game::WakeMap(Map* map, const ResRef& resRef)
+{
+	map->Dormant = false;
+
+	for (Actor* pc : PCs) {
+		if (pc->AreaName == resRef) {
+			map->AddActor(pc, false);
+		}
+	}
+
+	PlacePersistents(map, resRef);
+	map->InitActors();
+
+	// a fresh IniSpawn, so the enter spawns and the party placement happen again
+	if (core->HasFeature(GFFlags::SPAWN_INI)) {
+		map->UpdateFog();
+		map->LoadIniSpawn();
+	}
+
+	core->GetAudioDrv()->UpdateMapAmbient(map->GetReverbProperties());
+}
+
 void Game::PlacePersistents(Map *newMap, const ResRef &resRef)
 {
 	// count the number of replaced actors, so we don't need to recheck them
@@ -810,7 +876,8 @@ void Game::PlacePersistents(Map *newMap, const ResRef &resRef)
 	size_t last = NPCs.size() - 1;
 	for (size_t i = 0; i < NPCs.size(); i++) {
 		if (NPCs[i]->AreaName == resRef) {
-			if (i <= last && CheckForReplacementActor(i)) {
+			// actors still in a dormant map are kept as they are
+			if (i <= last && !newMap->HasActor(NPCs[i]) && CheckForReplacementActor(i)) {
 				i--;
 				last--;
 				continue;
@@ -828,6 +895,9 @@ int Game::LoadMap(const ResRef &resRef, bool loadscreen)
 
 	int index = FindMap(resRef);
 	if (index>=0) {
+		if (Maps[index]->Dormant) {
+			WakeMap(Maps[index], resRef);
+		}
 		return index;
 	}
 
@@ -876,6 +946,7 @@ int Game::LoadMap(const ResRef &resRef, bool loadscreen)
 	}
 
 	core->GetAudioDrv()->UpdateMapAmbient(newMap->GetReverbProperties());
+	newMap->PrefetchSounds();
 
 	core->LoadProgress(100);
 	return ret;
@@ -1600,8 +1671,11 @@ void Game::UpdateScripts()
 
 		//starting from 0, so we see the most recent master area first
 		for(unsigned int i=0;i<idx;i++) {
+			const Map* map = GetMap(i);
+			if (map && map->Dormant) continue;
 			DelMap(i, false);
 		}
+		EvictDormantMaps();
 	}
 
 	//this is used only for the death delay so far
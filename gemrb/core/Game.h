@@ -373,6 +373,10 @@ public:
 	 * if you want to change the pathfinder too. */
 	int LoadMap(const ResRef& resRef, bool loadScreen);
 	int DelMap(unsigned int index, int forced = 0);
+	/** Swaps out the least recently visited dormant maps, until they fit in AreaCacheSize */
+	void EvictDormantMaps();
+	/** Redoes the entry steps LoadMap skips for a dormant map */
+	void WakeMap(Map* map, const ResRef& resRef);
 	int AddNPC(Actor* npc);
 	Actor* GetNPC(unsigned int Index) const;
 	void SwapPCs(unsigned int pc1, unsigned int pc2) const;
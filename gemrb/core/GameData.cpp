@@ -36,6 +36,7 @@
 #include "Item.h"
 #include "ItemMgr.h"
 #include "PluginMgr.h"
+#include "Profiler.h"
 #include "ResourceDesc.h"
 #include "ScriptedAnimation.h"
 #include "Spell.h"
@@ -64,13 +65,45 @@ GameData::~GameData()
 
 Actor* GameData::GetCreature(const ResRef& creature, unsigned int PartySlot)
 {
-	DataStream* ds = GetResourceStream(creature, IE_CRE_CLASS_ID);
-	auto actormgr = GetImporter<ActorMgr>(IE_CRE_CLASS_ID, ds);
-	if (!actormgr) {
-		return 0;
+	if (PartySlot) {
+		// the scripts are set up differently for party members, which are rarely loaded like this anyway
+		DataStream* ds = GetResourceStream(creature, IE_CRE_CLASS_ID);
+		auto actormgr = GetImporter<ActorMgr>(IE_CRE_CLASS_ID, ds);
+		if (!actormgr) {
+			return nullptr;
+		}
+		return actormgr->GetActor(PartySlot);
 	}
-	Actor* actor = actormgr->GetActor(PartySlot);
-	return actor;
+
+	std::string key = creature.c_str();
+	StringToLower(key);
+	const CreatureTemplate* cre = creatureTemplates.Lookup(key);
+	if (cre) {
+		creatureTemplates.Touch(key);
+		Profiler::Count(ProfileCounter::CacheHits);
+	} else {
+		DataStream* ds = GetResourceStream(creature, IE_CRE_CLASS_ID);
+		if (!ds) {
+			return nullptr;
+		}
+		size_t bytes = ds->Size() + sizeof(Actor);
+		auto actormgr = GetImporter<ActorMgr>(IE_CRE_CLASS_ID, ds);
+		if (!actormgr) {
+			return nullptr;
+		}
+		Actor* actorTemplate = actormgr->GetActorTemplate();
+		if (!actorTemplate) {
+			return nullptr;
+		}
+		cre = creatureTemplates.SetAt(key, std::move(actormgr), actorTemplate, bytes);
+	}
+
+	return cre->importer->CopyActor(*cre->actor);
+}
+
+void GameData::ClearCreatureCache()
+{
+	creatureTemplates.Clear();
 }
 
 int GameData::LoadCreature(const ResRef& creature, unsigned int PartySlot, bool character, int VersionOverride)
@@ -331,7 +364,10 @@ Factory::object_t GameData::GetFactoryResource(const ResRef& resName, SClass_ID
 
 	// already cached?
 	int objectIndex = factory.IsLoaded(resName, type);
-	if (objectIndex != -1) return factory.GetFactoryObject(objectIndex);
+	if (objectIndex != -1) {
+		Profiler::Count(ProfileCounter::CacheHits);
+		return factory.GetFactoryObject(objectIndex);
+	}
 
 	switch (type) {
 	case IE_BAM_CLASS_ID:
@@ -25,6 +25,7 @@
 #include "exports.h"
 #include "ie_types.h"
 
+#include "ActorMgr.h"
 #include "Cache.h"
 #include "CharAnimations.h"
 #include "DisplayMessage.h"
@@ -32,6 +33,7 @@
 #include "Factory.h"
 #include "Holder.h"
 #include "Item.h"
+#include "LRUCache.h"
 #include "Palette.h"
 #include "Resource.h"
 #include "ResourceManager.h"
@@ -103,6 +105,8 @@ public:
 	Actor* GetCreature(const ResRef& creature, unsigned int PartySlot = 0);
 	/** Returns a PC index, by loading a creature */
 	int LoadCreature(const ResRef& creature, unsigned int PartySlot, bool character = false, int VersionOverride = -1);
+	/** Forgets the cached creature files, so they are looked up anew */
+	void ClearCreatureCache();
 
 
 	// 2DA table functions.
@@ -200,6 +204,25 @@ private:
 	void ReadItemSounds();
 	void ReadSpellProtTable();
 private:
+	// recently created creatures, parsed once, so respawning them only copies the template
+	// the importer is kept too, since it rerolls the random parts of each copy
+	struct CreatureTemplate {
+		PluginHolder<ActorMgr> importer;
+		std::unique_ptr<Actor> actor;
+		size_t bytes;
+
+		CreatureTemplate(PluginHolder<ActorMgr> importer, Actor* actor, size_t bytes)
+		: importer(std::move(importer)), actor(actor), bytes(bytes) {}
+		void evictionNotice() const {}
+	};
+	struct CreatureTemplateUnused {
+		bool operator()(const CreatureTemplate&) const { return true; }
+	};
+	struct CreatureTemplateSize {
+		size_t operator()(const CreatureTemplate& cre) const { return cre.bytes; }
+	};
+	LRUCache<CreatureTemplate, CreatureTemplateUnused, CreatureTemplateSize> creatureTemplates { 64, 2 * 1024 * 1024 };
+
 	ResRefRCCache<Item> ItemCache;
 	ResRefRCCache<Spell> SpellCache;
 	ResRefRCCache<Effect> EffectCache;
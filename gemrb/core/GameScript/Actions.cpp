@@ -120,12 +120,12 @@ void GameScript::NoAction(Scriptable* /*Sender*/, Action* /*parameters*/)
 
 void GameScript::SG(Scriptable* Sender, Action* parameters)
 {
-	SetVariable( Sender, parameters->string0Parameter, parameters->int0Parameter, "GLOBAL");
+	SetVariable( Sender, parameters->GetVariableRef(0, "GLOBAL"), parameters->int0Parameter);
 }
 
 void GameScript::SetGlobal(Scriptable* Sender, Action* parameters)
 {
-	SetVariable( Sender, parameters->string0Parameter, parameters->int0Parameter );
+	SetVariable( Sender, parameters->GetVariableRef(0), parameters->int0Parameter );
 }
 
 void GameScript::SetGlobalRandom(Scriptable* Sender, Action* parameters)
@@ -139,7 +139,7 @@ void GameScript::SetGlobalRandom(Scriptable* Sender, Action* parameters)
 	} else if (max > 0) {
 		value = RandomNumValue % max + parameters->int0Parameter; // should be +1 instead?
 	}
-	SetVariable(Sender, parameters->string0Parameter, value, parameters->resref1Parameter);
+	SetVariable(Sender, parameters->GetVariableRef(0, parameters->resref1Parameter), value);
 }
 
 void GameScript::StartTimer(Scriptable* Sender, Action* parameters)
@@ -158,7 +158,7 @@ void GameScript::SetGlobalTimer(Scriptable* Sender, Action* parameters)
 	ieDword mytime;
 
 	mytime=core->GetGame()->GameTime; //gametime (should increase it)
-	SetVariable( Sender, parameters->string0Parameter,
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		parameters->int0Parameter * core->Time.defaultTicksPerSec + mytime);
 }
 
@@ -177,17 +177,17 @@ void GameScript::SetGlobalTimerRandom(Scriptable* Sender, Action* parameters)
 		random = RandomNumValue % random + parameters->int1Parameter;
 	}
 	mytime=core->GetGame()->GameTime; //gametime (should increase it)
-	SetVariable(Sender, parameters->string0Parameter, random * core->Time.defaultTicksPerSec + mytime);
+	SetVariable(Sender, parameters->GetVariableRef(0), random * core->Time.defaultTicksPerSec + mytime);
 }
 
 void GameScript::SetGlobalTimerOnce(Scriptable* Sender, Action* parameters)
 {
-	ieDword mytime = CheckVariable( Sender, parameters->string0Parameter );
+	ieDword mytime = CheckVariable( Sender, parameters->GetVariableRef(0) );
 	if (mytime != 0) {
 		return;
 	}
 	mytime=core->GetGame()->GameTime; //gametime (should increase it)
-	SetVariable( Sender, parameters->string0Parameter,
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		parameters->int0Parameter * core->Time.defaultTicksPerSec + mytime);
 }
 
@@ -195,7 +195,7 @@ void GameScript::RealSetGlobalTimer(Scriptable* Sender, Action* parameters)
 {
 	ieDword mytime=core->GetGame()->RealTime;
 
-	SetVariable( Sender, parameters->string0Parameter,
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		parameters->int0Parameter * core->Time.defaultTicksPerSec + mytime);
 }
 
@@ -1067,7 +1067,7 @@ void GameScript::CreateCreatureAtLocation(Scriptable* Sender, Action* parameters
 	if (parameters->variable0Parameter.IsEmpty()) {
 		parameters->variable0Parameter = "LOCALSsavedlocation";
 	}
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->GetVariableRef(0));
 	parameters->pointParameter.y = (ieWord) (value & 0xffff);
 	parameters->pointParameter.x = (ieWord) (value >> 16);
 	CreateCreatureCore(Sender, parameters, CC_CHECK_IMPASSABLE|CC_STRING1);
@@ -2156,7 +2156,7 @@ void GameScript::PlaySequence(Scriptable* Sender, Action* parameters)
 //same as PlaySequence, but the value comes from a variable
 void GameScript::PlaySequenceGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->GetVariableRef(0));
 	PlaySequenceCore(Sender, parameters, value);
 }
 
@@ -3240,7 +3240,7 @@ void GameScript::SetToken(Scriptable* /*Sender*/, Action* parameters)
 //Assigns a numeric variable to the token
 void GameScript::SetTokenGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable( Sender, parameters->string0Parameter );
+	ieDword value = CheckVariable( Sender, parameters->GetVariableRef(0) );
 	SetTokenAsString(parameters->variable1Parameter, value);
 }
 
@@ -3357,33 +3357,33 @@ void GameScript::AnkhegHide(Scriptable* Sender, Action* /*parameters*/)
 
 void GameScript::GlobalSetGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable( Sender, parameters->string0Parameter );
-	SetVariable( Sender, parameters->string1Parameter, value );
+	ieDword value = CheckVariable( Sender, parameters->GetVariableRef(0) );
+	SetVariable( Sender, parameters->GetVariableRef(1), value );
 }
 
 /* adding the second variable to the first, they must be GLOBAL */
 void GameScript::AddGlobals(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable( Sender, parameters->string0Parameter, "GLOBAL");
-	ieDword value2 = CheckVariable( Sender, parameters->string1Parameter, "GLOBAL");
-	SetVariable( Sender, parameters->string0Parameter, value1 + value2, "GLOBAL");
+	ieDword value1 = CheckVariable( Sender, parameters->GetVariableRef(0, "GLOBAL"));
+	ieDword value2 = CheckVariable( Sender, parameters->GetVariableRef(1, "GLOBAL"));
+	SetVariable( Sender, parameters->GetVariableRef(0, "GLOBAL"), value1 + value2);
 }
 
 /* adding the second variable to the first, they could be area or locals */
 void GameScript::GlobalAddGlobal(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = CheckVariable( Sender,
-		parameters->string1Parameter );
-	SetVariable( Sender, parameters->string0Parameter, value1 + value2 );
+		parameters->GetVariableRef(1) );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 + value2 );
 }
 
 /* adding the number to the global, they could be area or locals */
 void GameScript::IncrementGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable( Sender, parameters->string0Parameter );
-	SetVariable( Sender, parameters->string0Parameter,
+	ieDword value = CheckVariable( Sender, parameters->GetVariableRef(0) );
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		value + parameters->int0Parameter );
 }
 
@@ -3391,183 +3391,183 @@ void GameScript::IncrementGlobal(Scriptable* Sender, Action* parameters)
 // only user: 0901tria.baf:    IncrementGlobalOnce("Evil_Trias_2","GLOBAL","Good","GLOBAL",-1)
 void GameScript::IncrementGlobalOnce(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->GetVariableRef(0));
 	if (value != 0) {
 		return;
 	}
-	SetVariable(Sender, parameters->string0Parameter, 1);
+	SetVariable(Sender, parameters->GetVariableRef(0), 1);
 
-	value = CheckVariable(Sender, parameters->string1Parameter);
-	SetVariable(Sender, parameters->string1Parameter, ieDword(int(value) + parameters->int0Parameter));
+	value = CheckVariable(Sender, parameters->GetVariableRef(1));
+	SetVariable(Sender, parameters->GetVariableRef(1), ieDword(int(value) + parameters->int0Parameter));
 }
 
 void GameScript::GlobalSubGlobal(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = CheckVariable( Sender,
-		parameters->string1Parameter );
-	SetVariable( Sender, parameters->string0Parameter, value1 - value2 );
+		parameters->GetVariableRef(1) );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 - value2 );
 }
 
 void GameScript::GlobalAndGlobal(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = CheckVariable( Sender,
-		parameters->string1Parameter );
-	SetVariable( Sender, parameters->string0Parameter, value1 && value2 );
+		parameters->GetVariableRef(1) );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 && value2 );
 }
 
 void GameScript::GlobalOrGlobal(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = CheckVariable( Sender,
-		parameters->string1Parameter );
-	SetVariable( Sender, parameters->string0Parameter, value1 || value2 );
+		parameters->GetVariableRef(1) );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 || value2 );
 }
 
 void GameScript::GlobalBOrGlobal(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = CheckVariable( Sender,
-		parameters->string1Parameter );
-	SetVariable( Sender, parameters->string0Parameter, value1 | value2 );
+		parameters->GetVariableRef(1) );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 | value2 );
 }
 
 void GameScript::GlobalBAndGlobal(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = CheckVariable( Sender,
-		parameters->string1Parameter );
-	SetVariable( Sender, parameters->string0Parameter, value1 & value2 );
+		parameters->GetVariableRef(1) );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 & value2 );
 }
 
 void GameScript::GlobalXorGlobal(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = CheckVariable( Sender,
-		parameters->string1Parameter );
-	SetVariable( Sender, parameters->string0Parameter, value1 ^ value2 );
+		parameters->GetVariableRef(1) );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 ^ value2 );
 }
 
 void GameScript::GlobalBOr(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
-	SetVariable( Sender, parameters->string0Parameter,
+		parameters->GetVariableRef(0) );
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		value1 | parameters->int0Parameter );
 }
 
 void GameScript::GlobalBAnd(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
-	SetVariable( Sender, parameters->string0Parameter,
+		parameters->GetVariableRef(0) );
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		value1 & parameters->int0Parameter );
 }
 
 void GameScript::GlobalXor(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
-	SetVariable( Sender, parameters->string0Parameter,
+		parameters->GetVariableRef(0) );
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		value1 ^ parameters->int0Parameter );
 }
 
 void GameScript::GlobalMax(Scriptable* Sender, Action* parameters)
 {
-	int value1 = CheckVariable( Sender, parameters->string0Parameter );
+	int value1 = CheckVariable( Sender, parameters->GetVariableRef(0) );
 	if (value1 > parameters->int0Parameter) {
-		SetVariable( Sender, parameters->string0Parameter, value1 );
+		SetVariable( Sender, parameters->GetVariableRef(0), value1 );
 	}
 }
 
 void GameScript::GlobalMin(Scriptable* Sender, Action* parameters)
 {
-	int value1 = CheckVariable( Sender, parameters->string0Parameter );
+	int value1 = CheckVariable( Sender, parameters->GetVariableRef(0) );
 	if (value1 < parameters->int0Parameter) {
-		SetVariable( Sender, parameters->string0Parameter, value1 );
+		SetVariable( Sender, parameters->GetVariableRef(0), value1 );
 	}
 }
 
 void GameScript::BitClear(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
-	SetVariable( Sender, parameters->string0Parameter,
+		parameters->GetVariableRef(0) );
+	SetVariable( Sender, parameters->GetVariableRef(0),
 		value1 & ~parameters->int0Parameter );
 }
 
 void GameScript::GlobalShL(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = parameters->int0Parameter;
 	if (value2 > 31) {
 		value1 = 0;
 	} else {
 		value1 <<= value2;
 	}
-	SetVariable( Sender, parameters->string0Parameter, value1 );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 );
 }
 
 void GameScript::GlobalShR(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable( Sender,
-		parameters->string0Parameter );
+		parameters->GetVariableRef(0) );
 	ieDword value2 = parameters->int0Parameter;
 	if (value2 > 31) {
 		value1 = 0;
 	} else {
 		value1 >>= value2;
 	}
-	SetVariable( Sender, parameters->string0Parameter, value1 );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 );
 }
 
 void GameScript::GlobalMaxGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable( Sender, parameters->string0Parameter );
-	ieDword value2 = CheckVariable( Sender, parameters->string1Parameter );
+	ieDword value1 = CheckVariable( Sender, parameters->GetVariableRef(0) );
+	ieDword value2 = CheckVariable( Sender, parameters->GetVariableRef(1) );
 	if (value1 < value2) {
-		SetVariable( Sender, parameters->string0Parameter, value2 );
+		SetVariable( Sender, parameters->GetVariableRef(0), value2 );
 	}
 }
 
 void GameScript::GlobalMinGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable( Sender, parameters->string0Parameter );
-	ieDword value2 = CheckVariable( Sender, parameters->string1Parameter );
+	ieDword value1 = CheckVariable( Sender, parameters->GetVariableRef(0) );
+	ieDword value2 = CheckVariable( Sender, parameters->GetVariableRef(1) );
 	if (value1 > value2) {
-		SetVariable( Sender, parameters->string0Parameter, value2 );
+		SetVariable( Sender, parameters->GetVariableRef(0), value2 );
 	}
 }
 
 void GameScript::GlobalShLGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable( Sender, parameters->string0Parameter );
-	ieDword value2 = CheckVariable( Sender, parameters->string1Parameter );
+	ieDword value1 = CheckVariable( Sender, parameters->GetVariableRef(0) );
+	ieDword value2 = CheckVariable( Sender, parameters->GetVariableRef(1) );
 	if (value2 > 31) {
 		value1 = 0;
 	} else {
 		value1 <<= value2;
 	}
-	SetVariable( Sender, parameters->string0Parameter, value1 );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 );
 }
 void GameScript::GlobalShRGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable( Sender, parameters->string0Parameter );
-	ieDword value2 = CheckVariable( Sender, parameters->string1Parameter );
+	ieDword value1 = CheckVariable( Sender, parameters->GetVariableRef(0) );
+	ieDword value2 = CheckVariable( Sender, parameters->GetVariableRef(1) );
 	if (value2 > 31) {
 		value1 = 0;
 	} else {
 		value1 >>= value2;
 	}
-	SetVariable( Sender, parameters->string0Parameter, value1 );
+	SetVariable( Sender, parameters->GetVariableRef(0), value1 );
 }
 
 void GameScript::ClearAllActions(Scriptable* Sender, Action* /*parameters*/)
@@ -3719,17 +3719,17 @@ void GameScript::SetTextColor(Scriptable* /*Sender*/, Action* parameters)
 
 void GameScript::BitGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter );
+	ieDword value = CheckVariable(Sender, parameters->GetVariableRef(0) );
 	HandleBitMod(value, parameters->int0Parameter, BitOp(parameters->int1Parameter));
-	SetVariable(Sender, parameters->string0Parameter, value);
+	SetVariable(Sender, parameters->GetVariableRef(0), value);
 }
 
 void GameScript::GlobalBitGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter );
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariableRef(0) );
+	ieDword value2 = CheckVariable(Sender, parameters->GetVariableRef(1) );
 	HandleBitMod(value1, value2, BitOp(parameters->int1Parameter));
-	SetVariable(Sender, parameters->string0Parameter, value1);
+	SetVariable(Sender, parameters->GetVariableRef(0), value1);
 }
 
 void GameScript::SetVisualRange(Scriptable* Sender, Action* parameters)
@@ -4235,7 +4235,7 @@ void GameScript::CreateItemNumGlobal(Scriptable *Sender, Action* parameters)
 		default:
 			return;
 	}
-	int value = CheckVariable( Sender, parameters->string0Parameter );
+	int value = CheckVariable( Sender, parameters->GetVariableRef(0) );
 	CREItem *item = new CREItem();
 	if (!CreateItemCore(item, parameters->resref1Parameter, value, 0, 0)) {
 		delete item;
@@ -5727,17 +5727,17 @@ void GameScript::RandomWalkContinuous(Scriptable* Sender, Action* /*parameters*/
 	if (actor->BlocksSearchMap()) {
 		area->ClearSearchMapFor(actor);
 	}
-	const auto path = area->RandomWalk(actor->Pos, actor->circleSize, std::max<int>(5, actor->maxWalkDistance), actor);
+	Path path;
+	area->RandomWalk(path, actor->Pos, actor->circleSize, std::max<int>(5, actor->maxWalkDistance), actor);
 	if (actor->BlocksSearchMap()) {
 		area->BlockSearchMapFor(actor);
 	}
-	if (path) {
+	if (!path.empty()) {
 		Action* moveAction = GenerateAction("MoveToPoint()");
-		moveAction->pointParameter = path->point;
+		moveAction->pointParameter = path.front().point;
 		Action* randomWalk = GenerateAction("RandomWalkContinuous()");
 		actor->AddActionInFront(randomWalk);
 		actor->AddActionInFront(moveAction);
-		delete path;
 	}
 
 	actor->ReleaseCurrentAction();
@@ -6486,7 +6486,7 @@ void GameScript::GetStat(Scriptable* Sender, Action* parameters)
 	if (actor) {
 		value = actor->GetStat( parameters->int0Parameter );
 	}
-	SetVariable( Sender, parameters->string0Parameter, value );
+	SetVariable( Sender, parameters->GetVariableRef(0), value );
 }
 
 void GameScript::BreakInstants(Scriptable* Sender, Action* /*parameters*/)
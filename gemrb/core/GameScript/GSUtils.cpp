@@ -50,6 +50,7 @@
 #include "ScriptedAnimation.h"
 
 #include <cstdio>
+#include <unordered_set>
 
 namespace GemRB {
 
@@ -613,7 +614,7 @@ int CanSee(const Scriptable *Sender, const Scriptable *target, bool range, int s
 		}
 	}
 
-	return map->IsVisibleLOS(target->Pos, Sender->Pos);
+	return map->IsVisibleLOS(target, Sender);
 }
 
 //non actors can see too (reducing function to LOS)
@@ -1570,7 +1571,7 @@ void AttackCore(Scriptable *Sender, Scriptable *target, int flags)
 	float_t angle = AngleFromPoints(attacker->Pos, target->Pos);
 	if (attacker->GetCurrentArea() != target->GetCurrentArea() ||
 		!WithinPersonalRange(attacker, target, weaponRange) ||
-		!attacker->GetCurrentArea()->IsVisibleLOS(attacker->Pos, target->Pos) ||
+		!attacker->GetCurrentArea()->IsVisibleLOS(attacker, target) ||
 		!CanSee(attacker, target, true, 0)) {
 		MoveNearerTo(attacker, target, Feet2Pixels(weaponRange, angle));
 		return;
@@ -1785,6 +1786,127 @@ void SetVariable(Scriptable* Sender, const StringParam& VarName, ieDword value,
 	}
 }
 
+// bumped whenever a variable map is destroyed, so no stale slot is ever used
+static uint32_t variableEpoch = 1;
+
+const ieVariable* InternVariable(const ieVariable& name)
+{
+	static std::unordered_set<ieVariable, CstrHashCI> names;
+	return &*names.insert(name).first;
+}
+
+void InvalidateVariableRefs()
+{
+	++variableEpoch;
+}
+
+void VariableRef::Resolve(const StringParam& varName, const ResRef& ctx)
+{
+	ieVariable name{varName};
+	explicitContext = ctx;
+	context = ctx;
+	if (context.IsEmpty()) {
+		const char* bareName = &varName[6];
+		//some HoW triggers use a : to separate the scope from the variable name
+		if (*bareName == ':') {
+			bareName++;
+		}
+		context.Format("{:.6}", varName);
+		name = ieVariable{bareName};
+	}
+	key = InternVariable(name);
+	slot = nullptr;
+
+	if (context == "MYAREA") {
+		scope = VarScope::MyArea;
+	} else if (context == "LOCALS") {
+		scope = VarScope::Locals;
+	} else if (HasKaputz && context == "KAPUTZ") {
+		scope = VarScope::Kaputz;
+	} else if (context == "GLOBAL") {
+		scope = VarScope::Global;
+	} else {
+		scope = VarScope::Area;
+	}
+}
+
+// the variable's value slot or nullptr if it doesn't exist (and can't be created)
+static ieDword* LookupVariable(Scriptable* Sender, const VariableRef& ref, bool create, bool* valid)
+{
+	// LOCALS can't be cached, since the same script runs for many actors
+	const void* owner = ref.scope == VarScope::MyArea ? Sender->GetCurrentArea() : nullptr;
+	if (ref.slot && ref.scope != VarScope::Locals && ref.slotEpoch == variableEpoch && ref.slotOwner == owner) {
+		return ref.slot;
+	}
+
+	ieVarsMap* vars = nullptr;
+	Game* game = core->GetGame();
+	switch (ref.scope) {
+		case VarScope::MyArea:
+			vars = &Sender->GetCurrentArea()->locals;
+			break;
+		case VarScope::Locals:
+			vars = &Sender->locals;
+			break;
+		case VarScope::Kaputz:
+			vars = &game->kaputz;
+			break;
+		case VarScope::Global:
+			vars = &game->locals;
+			break;
+		default: {
+			Map* map = game->GetMap(game->FindMap(ref.context));
+			if (map) {
+				vars = &map->locals;
+			}
+			break;
+		}
+	}
+	if (!vars) {
+		if (valid) *valid = false;
+		ScriptDebugLog(DebugMode::VARIABLES, "Invalid variable {} {}", ref.context, *ref.key);
+		return nullptr;
+	}
+
+	ieDword* slot = nullptr;
+	auto lookup = vars->find(*ref.key);
+	if (lookup != vars->end()) {
+		slot = &lookup->second;
+	} else if (create && !NoCreate) {
+		slot = &(*vars)[*ref.key];
+	} else {
+		return nullptr;
+	}
+
+	// references to unordered_map values stay valid until erased
+	if (ref.scope != VarScope::Locals) {
+		ref.slot = slot;
+		ref.slotOwner = owner;
+		ref.slotEpoch = variableEpoch;
+	}
+	return slot;
+}
+
+void SetVariable(Scriptable* Sender, const VariableRef& ref, ieDword value)
+{
+	ScriptDebugLog(DebugMode::VARIABLES, "Setting variable(\"{}{}\", {})", ref.context, *ref.key, value);
+	ieDword* slot = LookupVariable(Sender, ref, true, nullptr);
+	if (slot) {
+		*slot = value;
+	}
+}
+
+ieDword CheckVariable(const Scriptable* Sender, const VariableRef& ref, bool* valid)
+{
+	// the lookup only writes to the maps when creating
+	const ieDword* slot = LookupVariable(const_cast<Scriptable*>(Sender), ref, false, valid);
+	if (!slot) {
+		return 0;
+	}
+	ScriptDebugLog(DebugMode::VARIABLES, "CheckVariable {}{}: {}", ref.context, *ref.key, *slot);
+	return *slot;
+}
+
 void SetPointVariable(Scriptable *Sender, const StringParam& VarName, const Point &p, const VarContext& Context)
 {
 	SetVariable(Sender, VarName, ((p.y & 0xFFFF) << 16) | (p.x & 0xFFFF), Context);
@@ -2313,7 +2435,7 @@ void SpellCore(Scriptable *Sender, Action *parameters, int flags)
 				gamedata->FreeSpell(spl, Sender->SpellResRef, false);
 				return;
 			}
-			if (!Sender->GetCurrentArea()->IsVisibleLOS(Sender->Pos, tar->Pos)) {
+			if (!Sender->GetCurrentArea()->IsVisibleLOS(Sender, tar)) {
 				if (!(spl->Flags&SF_NO_LOS)) {
 					gamedata->FreeSpell(spl, Sender->SpellResRef, false);
 					MoveNearerTo(Sender, tar, dist);
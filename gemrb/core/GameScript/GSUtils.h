@@ -126,6 +126,7 @@ bool IsInObjectRect(const Point &pos, const Region &rect);
 Action *ParamCopy(const Action *parameters);
 Action *ParamCopyNoOverride(const Action *parameters);
 GEM_EXPORT void SetVariable(Scriptable* Sender, const StringParam& VarName, ieDword value, VarContext Context = {});
+GEM_EXPORT void SetVariable(Scriptable* Sender, const VariableRef& ref, ieDword value);
 GEM_EXPORT void SetPointVariable(Scriptable* Sender, const StringParam& VarName, const Point &point, const VarContext& Context = {});
 Point GetEntryPoint(const ResRef& areaname, const ResRef& entryname);
 //these are used from other plugins
@@ -137,6 +138,7 @@ GEM_EXPORT void DisplayStringCore(Scriptable* Sender, ieStrRef str, int flags, c
 bool CreateMovementEffect(Actor* actor, const ResRef& area, const Point &position, int face);
 GEM_EXPORT void MoveBetweenAreasCore(Actor* actor, const ResRef &area, const Point &position, int face, bool adjust);
 GEM_EXPORT ieDword CheckVariable(const Scriptable *Sender, const StringParam& VarName, VarContext Context = {}, bool *valid = nullptr);
+GEM_EXPORT ieDword CheckVariable(const Scriptable* Sender, const VariableRef& ref, bool* valid = nullptr);
 GEM_EXPORT Point CheckPointVariable(const Scriptable *Sender, const StringParam& VarName, const VarContext& Context = {}, bool *valid = nullptr);
 GEM_EXPORT bool VariableExists(const Scriptable *Sender, const StringParam& VarName, const VarContext& Context);
 Action* GenerateActionCore(const char *src, const char *str, unsigned short actionID);
@@ -47,12 +47,15 @@
 #include "GameData.h"
 #include "Interface.h"
 #include "PluginMgr.h"
+#include "Profiler.h"
 #include "RNG.h"
 #include "TableMgr.h"
 
 #include "GUI/GameControl.h"
 #include "GameScript/GSUtils.h"
 #include "GameScript/Matching.h"
+#include "GameScript/ScriptCache.h"
+#include "Streams/MemoryStream.h"
 
 #include <cstdarg>
 
@@ -1750,6 +1753,16 @@ void InitializeIEScript()
 }
 
 /********************** GameScript *******************************/
+// approximate memory held by BcsCache
+static size_t ScriptCacheUsage = 0;
+
+static void AccountScript(const ResRef& resRef, Script& script)
+{
+	script.footprint = ScriptFootprint(script);
+	ScriptCacheUsage += script.footprint;
+	Log(DEBUG, "GameScript", "Cached script {}: {} bytes, {} bytes in total", resRef, script.footprint, ScriptCacheUsage);
+}
+
 GameScript::GameScript(const ResRef& resref, Scriptable* MySelf,
 	int ScriptLevel, bool AIScript)
 	: MySelf(MySelf), Name(resref), scriptlevel(ScriptLevel)
@@ -1759,7 +1772,10 @@ GameScript::GameScript(const ResRef& resref, Scriptable* MySelf,
 
 GameScript::~GameScript(void)
 {
-	BcsCache.DecRef(Name, true);
+	size_t footprint = script ? script->footprint : 0;
+	if (BcsCache.DecRef(Name, true) == 0) {
+		ScriptCacheUsage -= footprint;
+	}
 }
 
 Script* GameScript::CacheScript(const ResRef& resRef, bool AIScript)
@@ -1776,24 +1792,45 @@ Script* GameScript::CacheScript(const ResRef& resRef, bool AIScript)
 		return NULL;
 	}
 
+	// parse from memory, it's also needed whole for hashing
+	strpos_t length = stream->Remains();
+	char* source = (char*) malloc(length);
+	stream->Read(source, length);
+	delete stream;
+	MemoryStream text(resRef.c_str(), source, length);
+
 	std::string line;
-	stream->ReadLine(line, 10);
+	text.ReadLine(line, 10);
 	if (line.compare(0, 2, "SC") != 0) {
 		Log(WARNING, "GameScript", "Not a Compiled Script file");
-		delete stream;
 		return nullptr;
 	}
 
 	auto newScript = BcsCache.SetAt(resRef).first;
 
+	uint32_t hash = 0;
+	path_t imagePath;
+	if (core->config.CompiledScriptCache) {
+		hash = HashScriptSource(source, length, type);
+		imagePath = PathJoinExt(core->config.CachePath, resRef, AIScript ? "bsc" : "bcsc");
+		if (LoadCompiledScript(imagePath, hash, *newScript)) {
+			AccountScript(resRef, *newScript);
+			return newScript;
+		}
+	}
+
 	while (true) {
-		ResponseBlock* rB = ReadResponseBlock( stream );
+		ResponseBlock* rB = ReadResponseBlock(&text);
 		if (!rB)
 			break;
 		newScript->responseBlocks.push_back( rB );
-		stream->ReadLine( line, 10 );
+		text.ReadLine(line, 10);
 	}
-	delete stream;
+
+	if (!imagePath.empty() && !SaveCompiledScript(imagePath, hash, *newScript)) {
+		Log(WARNING, "GameScript", "Could not cache the compiled script: {}", imagePath);
+	}
+	AccountScript(resRef, *newScript);
 	return newScript;
 }
 
@@ -1813,6 +1850,8 @@ bool GameScript::Update(bool *continuing, bool *done)
 	if (!script)
 		return false;
 
+	PROFILE_ZONE(Scripts);
+
 	if(!(MySelf->GetInternalFlag()&IF_ACTIVE) ) {
 		return false;
 	}
@@ -2316,6 +2355,15 @@ bool Object::isNull() const
 	return true;
 }
 
+const VariableRef& Trigger::GetVariableRef(size_t idx, const ResRef& context) const
+{
+	const VariableRef& ref = varRefs[idx];
+	if (!ref.ResolvedFor(context)) {
+		varRefs[idx].Resolve(idx ? string1Parameter : string0Parameter, context);
+	}
+	return ref;
+}
+
 std::string Trigger::dump() const
 {
 	AssertCanary(__func__);
@@ -2335,6 +2383,15 @@ std::string Trigger::dump() const
 	return buffer;
 }
 
+const VariableRef& Action::GetVariableRef(size_t idx, const ResRef& context) const
+{
+	const VariableRef& ref = varRefs[idx];
+	if (!ref.ResolvedFor(context)) {
+		varRefs[idx].Resolve(idx ? string1Parameter : string0Parameter, context);
+	}
+	return ref;
+}
+
 std::string Action::dump() const
 {
 	AssertCanary(__func__);
@@ -157,6 +157,44 @@ public:
 	bool isNull() const;
 };
 
+enum class VarScope : uint8_t {
+	Unresolved,
+	Global,
+	Locals,
+	MyArea,
+	Kaputz,
+	Area // map name context, eg. AR1324
+};
+
+/** Interns a variable name, equal names (ignoring case) share the same copy */
+GEM_EXPORT const ieVariable* InternVariable(const ieVariable& name);
+/** Drops all the cached variable slots, needed whenever a variable map goes away */
+GEM_EXPORT void InvalidateVariableRefs();
+
+/**
+ * A script variable parameter with the scope and name already split up,
+ * so evaluating it doesn't have to parse and compare strings every time.
+ * The slot of the last lookup is remembered too (except for LOCALS, since
+ * the scripts are shared), the variables themselves stay in the usual
+ * name keyed maps, so saving and loading doesn't care.
+ */
+class GEM_EXPORT VariableRef {
+public:
+	VarScope scope = VarScope::Unresolved;
+	const ieVariable* key = nullptr;
+	// the scope as written in the script or the area name for VarScope::Area
+	ResRef context;
+	// the context that was passed in when resolving, if any
+	ResRef explicitContext;
+
+	mutable ieDword* slot = nullptr;
+	mutable const void* slotOwner = nullptr;
+	mutable uint32_t slotEpoch = 0;
+
+	void Resolve(const StringParam& varName, const ResRef& explicitContext);
+	bool ResolvedFor(const ResRef& ctx) const { return scope != VarScope::Unresolved && explicitContext == ctx; }
+};
+
 class GEM_EXPORT Trigger final : protected Canary {
 public:
 	Trigger() noexcept : string0Parameter(), string1Parameter() {};
@@ -189,6 +227,10 @@ public:
 		ResRef resref1Parameter;
 	};
 
+	// string0Parameter and string1Parameter resolved as variables, on first use
+	mutable VariableRef varRefs[2];
+	const VariableRef& GetVariableRef(size_t idx, const ResRef& context = {}) const;
+
 	std::string dump() const;
 
 	void Release()
@@ -258,6 +300,10 @@ public:
 		ResRef resref1Parameter;
 	};
 
+	// string0Parameter and string1Parameter resolved as variables, on first use
+	mutable VariableRef varRefs[2];
+	const VariableRef& GetVariableRef(size_t idx, const ResRef& context = {}) const;
+
 	uint32_t flags = 0;
 private:
 	int RefCount = 0;
@@ -370,6 +416,8 @@ public:
 	}
 
 	std::vector<ResponseBlock*> responseBlocks;
+	// approximate memory usage, see ScriptFootprint
+	size_t footprint = 0;
 
 	void Release()
 	{
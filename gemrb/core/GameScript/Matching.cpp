@@ -130,7 +130,7 @@ static inline bool DoObjectChecks(const Map* map, const Scriptable* Sender, Acto
 	}
 
 	// line of sight check
-	if (!map->IsVisibleLOS(Sender->Pos, target->Pos)) return false;
+	if (!map->IsVisibleLOS(Sender, target)) return false;
 
 	// protection against creature
 	if (target->fxqueue.HasEffect(fx_protection_creature_ref)) {
@@ -194,7 +194,7 @@ static Targets *EvaluateObject(const Map *map, const Scriptable *Sender, const O
 	Targets *tgts = NULL;
 
 	//we need to get a subset of actors from the large array
-	//if this gets slow, we will need some index tables
+	//the expensive LOS part of DoObjectChecks is cached per tick by the map
 	int i = map->GetActorCount(true);
 	while (i--) {
 		Actor *ac = map->GetActor(i, true);
@@ -0,0 +1,372 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "GameScript/ScriptCache.h"
+
+#include "GameScript/GameScript.h"
+#include "GameScript/GSUtils.h"
+
+#include "Interface.h"
+#include "MurmurHash.h"
+#include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
+
+namespace GemRB {
+
+// bump whenever the layout below or the parsed structures change
+static constexpr uint32_t ImageVersion = 1;
+static const char ImageSignature[8] = { 'G', 'E', 'M', 'B', 'C', 'S', 'V', '1' };
+
+// the image is a flat preorder dump of the tree, each list prefixed by its length
+class ImageWriter {
+	DataStream& str;
+
+public:
+	explicit ImageWriter(DataStream& str) : str(str) {}
+
+	template<typename T>
+	void WriteScalar(T value)
+	{
+		str.WriteScalar(value);
+	}
+
+	void WriteString(const StringParam& string)
+	{
+		str.Write(string.begin(), sizeof(string) - 1);
+	}
+
+	void WriteObject(const GemRB::Object* object)
+	{
+		WriteScalar<uint8_t>(object != nullptr);
+		if (!object) return;
+
+		for (int field : object->objectFields) {
+			WriteScalar(field);
+		}
+		for (int filter : object->objectFilters) {
+			WriteScalar(filter);
+		}
+		WriteScalar(object->objectRect.x);
+		WriteScalar(object->objectRect.y);
+		WriteScalar(object->objectRect.w);
+		WriteScalar(object->objectRect.h);
+		WriteString(object->objectName);
+	}
+
+	void WriteTrigger(const GemRB::Trigger& trigger)
+	{
+		WriteScalar(trigger.triggerID);
+		WriteScalar(trigger.int0Parameter);
+		WriteScalar(trigger.flags);
+		WriteScalar(trigger.int1Parameter);
+		WriteScalar(trigger.int2Parameter);
+		WriteScalar(trigger.pointParameter.x);
+		WriteScalar(trigger.pointParameter.y);
+		WriteString(trigger.string0Parameter);
+		WriteString(trigger.string1Parameter);
+		WriteObject(trigger.objectParameter);
+	}
+
+	void WriteAction(const GemRB::Action& action)
+	{
+		WriteScalar(action.actionID);
+		WriteScalar(action.int0Parameter);
+		WriteScalar(action.pointParameter.x);
+		WriteScalar(action.pointParameter.y);
+		WriteScalar(action.int1Parameter);
+		WriteScalar(action.int2Parameter);
+		WriteScalar(action.flags);
+		WriteString(action.string0Parameter);
+		WriteString(action.string1Parameter);
+		for (const auto& object : action.objects) {
+			WriteObject(object);
+		}
+	}
+
+	void WriteResponseBlock(const GemRB::ResponseBlock& block)
+	{
+		const Condition* condition = block.condition;
+		WriteScalar<uint8_t>(condition != nullptr);
+		if (condition) {
+			WriteScalar<uint32_t>(uint32_t(condition->triggers.size()));
+			for (const auto& trigger : condition->triggers) {
+				WriteTrigger(*trigger);
+			}
+		}
+
+		const ResponseSet* responseSet = block.responseSet;
+		WriteScalar<uint8_t>(responseSet != nullptr);
+		if (responseSet) {
+			WriteScalar<uint32_t>(uint32_t(responseSet->responses.size()));
+			for (const auto& response : responseSet->responses) {
+				WriteScalar(response->weight);
+				WriteScalar<uint32_t>(uint32_t(response->actions.size()));
+				for (const auto& action : response->actions) {
+					WriteAction(*action);
+				}
+			}
+		}
+	}
+};
+
+class ImageReader {
+	DataStream& str;
+
+public:
+	bool failed = false;
+
+	explicit ImageReader(DataStream& str) : str(str) {}
+
+	template<typename T>
+	T ReadScalar()
+	{
+		T value {};
+		if (str.ReadScalar(value) == DataStream::Error) {
+			failed = true;
+		}
+		return value;
+	}
+
+	// list lengths, guarded so a broken image can't make us allocate like crazy
+	uint32_t ReadCount()
+	{
+		uint32_t count = ReadScalar<uint32_t>();
+		if (count > str.Remains()) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	void ReadString(StringParam& string)
+	{
+		if (str.Read(string.begin(), sizeof(string) - 1) == DataStream::Error) {
+			failed = true;
+		}
+	}
+
+	GemRB::Object* ReadObject()
+	{
+		if (!ReadScalar<uint8_t>()) return nullptr;
+
+		GemRB::Object* object = new GemRB::Object();
+		for (int& field : object->objectFields) {
+			field = ReadScalar<int>();
+		}
+		for (int& filter : object->objectFilters) {
+			filter = ReadScalar<int>();
+		}
+		object->objectRect.x = ReadScalar<int>();
+		object->objectRect.y = ReadScalar<int>();
+		object->objectRect.w = ReadScalar<int>();
+		object->objectRect.h = ReadScalar<int>();
+		ReadString(object->objectName);
+		return object;
+	}
+
+	GemRB::Trigger* ReadTrigger()
+	{
+		GemRB::Trigger* trigger = new GemRB::Trigger();
+		trigger->triggerID = ReadScalar<unsigned short>();
+		trigger->int0Parameter = ReadScalar<int>();
+		trigger->flags = ReadScalar<int>();
+		trigger->int1Parameter = ReadScalar<int>();
+		trigger->int2Parameter = ReadScalar<int>();
+		trigger->pointParameter.x = ReadScalar<int>();
+		trigger->pointParameter.y = ReadScalar<int>();
+		ReadString(trigger->string0Parameter);
+		ReadString(trigger->string1Parameter);
+		trigger->objectParameter = ReadObject();
+		if (trigger->triggerID >= MAX_TRIGGERS) {
+			failed = true;
+		}
+		return trigger;
+	}
+
+	GemRB::Action* ReadAction()
+	{
+		// not autofreed, because it is referenced by the Script
+		GemRB::Action* action = new GemRB::Action(false);
+		action->actionID = ReadScalar<unsigned short>();
+		action->int0Parameter = ReadScalar<int>();
+		action->pointParameter.x = ReadScalar<int>();
+		action->pointParameter.y = ReadScalar<int>();
+		action->int1Parameter = ReadScalar<int>();
+		action->int2Parameter = ReadScalar<int>();
+		action->flags = ReadScalar<uint32_t>();
+		ReadString(action->string0Parameter);
+		ReadString(action->string1Parameter);
+		for (auto& object : action->objects) {
+			object = ReadObject();
+		}
+		if (action->actionID >= MAX_ACTIONS) {
+			failed = true;
+		}
+		return action;
+	}
+
+	GemRB::ResponseBlock* ReadResponseBlock()
+	{
+		GemRB::ResponseBlock* block = new GemRB::ResponseBlock();
+		if (ReadScalar<uint8_t>()) {
+			block->condition = new Condition();
+			uint32_t count = ReadCount();
+			for (uint32_t i = 0; i < count && !failed; ++i) {
+				block->condition->triggers.push_back(ReadTrigger());
+			}
+		}
+
+		if (ReadScalar<uint8_t>()) {
+			block->responseSet = new ResponseSet();
+			uint32_t count = ReadCount();
+			for (uint32_t i = 0; i < count && !failed; ++i) {
+				Response* response = new Response();
+				block->responseSet->responses.push_back(response);
+				response->weight = ReadScalar<unsigned char>();
+				uint32_t actions = ReadCount();
+				for (uint32_t j = 0; j < actions && !failed; ++j) {
+					response->actions.push_back(ReadAction());
+				}
+			}
+		}
+		return block;
+	}
+};
+
+uint32_t HashScriptSource(const char* source, size_t length, SClass_ID type)
+{
+	Hasher hasher;
+	hasher.Feed(ImageVersion);
+	hasher.Feed(uint32_t(type));
+	// the parse depends on the trigger and action flags loaded from the game's tables
+	for (char c : core->config.GameType) {
+		hasher.Feed(uint8_t(c));
+	}
+	for (short flags : triggerflags) {
+		hasher.Feed(uint32_t(uint16_t(flags)));
+	}
+	for (uint16_t flags : actionflags) {
+		hasher.Feed(uint32_t(flags));
+	}
+	hasher.Feed(uint32_t(length));
+
+	size_t i = 0;
+	for (; i + 4 <= length; i += 4) {
+		uint32_t chunk;
+		memcpy(&chunk, source + i, 4);
+		hasher.Feed(chunk);
+	}
+	uint32_t tail = 0;
+	memcpy(&tail, source + i, length - i);
+	hasher.Feed(tail);
+
+	return hasher.GetHash().value;
+}
+
+bool LoadCompiledScript(const path_t& path, uint32_t hash, Script& script)
+{
+	FileStream* file = FileStream::OpenFile(path);
+	if (!file) {
+		return false;
+	}
+
+	// read it whole, so we don't go to the disk for every field
+	strpos_t size = file->Size();
+	void* data = malloc(size);
+	bool complete = file->Read(data, size) != DataStream::Error;
+	delete file;
+	MemoryStream str(path, data, size);
+	if (!complete) {
+		return false;
+	}
+
+	char signature[sizeof(ImageSignature)];
+	str.Read(signature, sizeof(signature));
+	ImageReader reader(str);
+	if (memcmp(signature, ImageSignature, sizeof(signature)) != 0 || reader.ReadScalar<uint32_t>() != hash) {
+		return false;
+	}
+
+	uint32_t count = reader.ReadCount();
+	script.responseBlocks.reserve(count);
+	for (uint32_t i = 0; i < count && !reader.failed; ++i) {
+		script.responseBlocks.push_back(reader.ReadResponseBlock());
+	}
+	if (reader.failed || str.Remains()) {
+		Log(WARNING, "GameScript", "Ignoring broken compiled script: {}", path);
+		for (auto& block : script.responseBlocks) {
+			block->Release();
+		}
+		script.responseBlocks.clear();
+		return false;
+	}
+	return true;
+}
+
+bool SaveCompiledScript(const path_t& path, uint32_t hash, const Script& script)
+{
+	FileStream file;
+	if (!file.Create(path)) {
+		return false;
+	}
+
+	file.Write(ImageSignature, sizeof(ImageSignature));
+	ImageWriter writer(file);
+	writer.WriteScalar(hash);
+	writer.WriteScalar<uint32_t>(uint32_t(script.responseBlocks.size()));
+	for (const auto& block : script.responseBlocks) {
+		writer.WriteResponseBlock(*block);
+	}
+	// a short write is caught by the size checks when loading
+	return true;
+}
+
+size_t ScriptFootprint(const Script& script)
+{
+	size_t bytes = sizeof(Script) + script.responseBlocks.capacity() * sizeof(ResponseBlock*);
+	auto objectSize = [](const Object* object) -> size_t {
+		return object ? sizeof(Object) : 0;
+	};
+
+	for (const auto& block : script.responseBlocks) {
+		bytes += sizeof(ResponseBlock);
+		const Condition* condition = block->condition;
+		if (condition) {
+			bytes += sizeof(Condition) + condition->triggers.capacity() * sizeof(Trigger*);
+			for (const auto& trigger : condition->triggers) {
+				bytes += sizeof(Trigger) + objectSize(trigger->objectParameter);
+			}
+		}
+
+		const ResponseSet* responseSet = block->responseSet;
+		if (!responseSet) continue;
+		bytes += sizeof(ResponseSet) + responseSet->responses.capacity() * sizeof(Response*);
+		for (const auto& response : responseSet->responses) {
+			bytes += sizeof(Response) + response->actions.capacity() * sizeof(Action*);
+			for (const auto& action : response->actions) {
+				bytes += sizeof(Action);
+				for (const auto& object : action->objects) {
+					bytes += objectSize(object);
+				}
+			}
+		}
+	}
+	return bytes;
+}
+
+}
@@ -0,0 +1,44 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+// Binary images of already parsed scripts, so the text B(C)S parser can be skipped
+
+#ifndef SCRIPTCACHE_H
+#define SCRIPTCACHE_H
+
+#include "SClassID.h"
+
+#include "System/VFS.h"
+
+namespace GemRB {
+
+class DataStream;
+class Script;
+
+/** Hashes the script source, along with everything else the parsed result depends on */
+uint32_t HashScriptSource(const char* source, size_t length, SClass_ID type);
+/** Fills the script from a compiled image, fails if it is missing, stale or broken */
+bool LoadCompiledScript(const path_t& path, uint32_t hash, Script& script);
+/** Dumps the parsed script, so the next load can use LoadCompiledScript */
+bool SaveCompiledScript(const path_t& path, uint32_t hash, const Script& script);
+/** Approximate heap usage of the parsed script tree */
+size_t ScriptFootprint(const Script& script);
+
+}
+
+#endif
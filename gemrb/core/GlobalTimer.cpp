@@ -29,9 +29,24 @@
 
 namespace GemRB {
 
+tick_t GlobalTimer::Now()
+{
+	if (!fixedStep) {
+		return GetMilliseconds();
+	}
+	fixedClock += fixedStep;
+	return fixedClock;
+}
+
+void GlobalTimer::SetFixedStep(tick_t step)
+{
+	fixedStep = step;
+	fixedClock = startTime;
+}
+
 void GlobalTimer::Freeze()
 {
-	tick_t thisTime = GetMilliseconds();
+	tick_t thisTime = Now();
 
 	if (UpdateViewport(thisTime) == false) {
 		return;
@@ -139,7 +154,7 @@ bool GlobalTimer::Update()
 	Map *map;
 	Game *game;
 	const GameControl* gc;
-	tick_t thisTime = GetMilliseconds();
+	tick_t thisTime = Now();
 
 	if (!startTime) {
 		goto end;
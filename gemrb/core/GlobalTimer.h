@@ -47,6 +47,11 @@ private:
 	int speed = 0;
 	Region currentVP;
 
+	// deterministic clock for headless runs, advanced by a fixed amount each frame
+	tick_t fixedStep = 0;
+	tick_t fixedClock = 0;
+
+	tick_t Now();
 	void DoFadeStep(ieDword count);
 	bool UpdateViewport(tick_t time);
 public:
@@ -57,6 +62,8 @@ public:
 
 	void Freeze();
 	bool Update();
+	/** makes every Update or Freeze advance the clock by step ms instead of reading the real time, 0 disables it */
+	void SetFixedStep(tick_t step);
 	bool IsFading() const;
 	bool ViewportIsMoving() const;
 	void DoStep(int count);
@@ -50,7 +50,9 @@
 #include "PluginLoader.h"
 #include "PluginMgr.h"
 #include "Predicates.h"
+#include "Profiler.h"
 #include "ProjectileServer.h"
+#include "SaveArchiveWriter.h"
 #include "SaveGameIterator.h"
 #include "SaveGameMgr.h"
 #include "ScriptedAnimation.h"
@@ -76,8 +78,10 @@
 #include "RNG.h"
 #include "Scriptable/Container.h"
 #include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
 #include "System/FileFilters.h"
 
+#include <chrono>
 #include <utility>
 #include <vector>
 
@@ -228,6 +232,10 @@ Interface::Interface(CoreSettings&& cfg)
 	core = this;
 	
 	SetDebugMode(DebugMode(config.debugMode));
+	if (config.EnableProfiler || !config.ProfilerCSV.empty()) {
+		Profiler::Enable(true);
+		Profiler::SetCSV(config.ProfilerCSV);
+	}
 	
 #if defined(WIN32)
 	const uint32_t codepage = GetACP();
@@ -351,7 +359,7 @@ Interface::Interface(CoreSettings&& cfg)
 	gamedata->AddSource(path, "shared GemRB Unhardcoded data", PLUGIN_RESOURCE_CACHEDDIRECTORY);
 
 	if (!config.UseAsLibrary) {
-		fogRenderer = std::make_unique<FogRenderer>(config.SpriteFoW);
+		fogRenderer = std::make_unique<FogRenderer>(config.SpriteFoW, config.RetainedFoW);
 
 		Log(MESSAGE, "Core", "Initializing GUI Script Engine...");
 		SetNextScript("Start"); // Start is the first script executed
@@ -942,6 +950,12 @@ void Interface::DisableMusicPlaylist(size_t SongType)
 /** this is the main loop */
 void Interface::Main()
 {
+	if (config.BenchmarkTicks > 0) {
+		RunBenchmark();
+		QuitGame(0);
+		return;
+	}
+
 	int speed = vars.Get("Mouse Scroll Speed", 10);
 	SetMouseScrollSpeed(speed + 1);
 
@@ -967,6 +981,9 @@ void Interface::Main()
 	// set for printing
 	fpsRgn.x = 5;
 	fpsRgn.y = 0;
+	// the profiler breakdown goes right below it, a line per zone and counter
+	Region profileRgn(5, 30, 200, fps->LineHeight * (UnderType(ProfileZone::count) + UnderType(ProfileCounter::count)));
+	String profileString;
 
 	tick_t frame = 0;
 	tick_t time = GetMilliseconds();
@@ -1011,23 +1028,100 @@ void Interface::Main()
 		}
 
 		winmgr->DrawWindows();
-		if (config.DrawFPS) {
+		Profiler::EndFrame();
+		if (config.DrawFPS || config.EnableProfiler) {
 			frame++;
 			if (time - timebase > 1000) {
 				frames = ( frame * 1000.0 / ( time - timebase ) );
 				timebase = time;
 				frame = 0;
 				fpsstring = fmt::format(u"{:.3f} fps", frames);
+				if (config.EnableProfiler) {
+					profileString = StringFromUtf8(Profiler::Report().c_str());
+				}
 			}
 			auto lock = winmgr->DrawHUD();
 			VideoDriver->DrawRect( fpsRgn, ColorBlack );
 			fps->Print(fpsRgn, String(fpsstring), IE_FONT_ALIGN_MIDDLE | IE_FONT_SINGLE_LINE, {ColorWhite, ColorBlack});
+			if (config.EnableProfiler) {
+				VideoDriver->DrawRect(profileRgn, ColorBlack);
+				fps->Print(profileRgn, profileString, IE_FONT_ALIGN_LEFT | IE_FONT_ALIGN_TOP, {ColorWhite, ColorBlack});
+			}
 		}
 
 	} while (VideoDriver->SwapBuffers(config.CapFPS) == GEM_OK && !(QuitFlag&QF_KILL));
 	QuitGame(0);
 }
 
+void Interface::RunBenchmark()
+{
+	using clock = std::chrono::steady_clock;
+
+	if (!config.BenchmarkSave.empty()) {
+		Holder<SaveGame> save = GetSaveGameIterator()->GetSaveGame(StringFromUtf8(config.BenchmarkSave.c_str()));
+		if (save) {
+			SetupLoadGame(std::move(save), 0);
+			QuitFlag |= QF_ENTERGAME;
+		} else {
+			Log(ERROR, "Core", "Benchmark save not found: {}, running just the GUI!", config.BenchmarkSave);
+		}
+	}
+
+	auto handleFlags = [this]() {
+		if (!QuitFlag || QuitFlag == QF_KILL) return;
+		while (QuitFlag && QuitFlag != QF_KILL) {
+			HandleFlags();
+		}
+		// HandleFlags resets the timer
+		timer.SetFixedStep(1000 / Time.ticksPerSec);
+	};
+
+	auto loadStart = clock::now();
+	handleFlags();
+	clock::duration loadTime = clock::now() - loadStart;
+
+	// a fixed clock and seed, so every run takes the same decisions
+	RNG::getInstance().Seed(config.BenchmarkSeed);
+	timer.SetFixedStep(1000 / Time.ticksPerSec);
+	uint64_t allocations = AllocationCounter ? AllocationCounter() : 0;
+
+	clock::duration updateTime {};
+	clock::duration drawTime {};
+	Profiler::Enable(true);
+	int ticks = 0;
+	for (; ticks < config.BenchmarkTicks && !(QuitFlag & QF_KILL); ++ticks) {
+		auto start = clock::now();
+		handleFlags();
+		GameLoop();
+		auto updated = clock::now();
+		winmgr->DrawWindows();
+		drawTime += clock::now() - updated;
+		updateTime += updated - start;
+		Profiler::EndFrame();
+	}
+
+	auto ms = [](clock::duration d) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / 1000.0;
+	};
+	double total = ms(updateTime + drawTime);
+	Log(MESSAGE, "Benchmark", "{} ticks (seed {}) in {:.1f}ms: {:.1f} ticks/s, loading took {:.1f}ms",
+		ticks, config.BenchmarkSeed, total, total > 0 ? ticks * 1000.0 / total : 0.0, ms(loadTime));
+	Log(MESSAGE, "Benchmark", "Game update {:.1f}ms, drawing {:.1f}ms", ms(updateTime), ms(drawTime));
+	Log(MESSAGE, "Benchmark", "Per tick:\n{}", Profiler::Report());
+	if (game) {
+		for (size_t i = 0; i < game->GetLoadedMapCount(); ++i) {
+			const Map* map = game->GetMap(unsigned(i));
+			const auto& stats = map->GetScriptTotals();
+			Log(MESSAGE, "Benchmark", "{}: {} actor script evaluations, {:.1f}ms of actor updates",
+				map->GetScriptRef(), stats.evaluations, stats.micros / 1000.0);
+		}
+	}
+	if (AllocationCounter) {
+		uint64_t count = AllocationCounter() - allocations;
+		Log(MESSAGE, "Benchmark", "{} heap allocations, {:.1f} per tick", count, ticks ? double(count) / ticks : 0.0);
+	}
+}
+
 void Interface::InitVideo() const
 {
 	Log(MESSAGE, "Core", "Initializing Video Driver...");
@@ -1786,7 +1880,7 @@ bool Interface::IsFreezed() const
 
 void Interface::GameLoop(void)
 {
-	TRACY(ZoneScoped);
+	PROFILE_ZONE(GameUpdate);
 	update_scripts = false;
 	GameControl *gc = GetGameControl();
 	if (gc) {
@@ -2369,6 +2463,7 @@ void Interface::QuitGame(int BackToMain)
 		delete worldmap;
 		worldmap = nullptr;
 	}
+	gamedata->ClearCreatureCache();
 	if (BackToMain) {
 		SetNextScript("Start");
 	}
@@ -2390,7 +2485,12 @@ void Interface::LoadGame(Holder<SaveGame> sg, int ver_override)
 
 	// Yes, it uses goto. Other ways seemed too awkward for me.
 
+	// the save being loaded could still be written out
+	sgiterator->FinishPendingSave();
+
 	gamedata->SaveAllStores();
+	// the new save or mod may ship different creature files
+	gamedata->ClearCreatureCache();
 	strings->CloseAux();
 	tokens.clear(); //clearing the token dictionary
 
@@ -3726,26 +3826,27 @@ static bool IsBlobSaveItem(const path_t& path) {
 	return areExt != path_t::npos && areExt == pathLength - 4;
 }
 
-int Interface::CompressSave(const path_t& folder, bool overrideRunning)
+int Interface::CompressSave(SaveArchiveWriter& archive, bool overrideRunning)
 {
-	FileStream str;
-
-	str.Create(folder, GameNameResRef.c_str(), IE_SAV_CLASS_ID);
 	DirectoryIterator dir(config.CachePath);
 	if (!dir) {
 		return GEM_ERROR;
 	}
-	PluginHolder<ArchiveImporter> ai = MakePluginHolder<ArchiveImporter>(IE_SAV_CLASS_ID);
-	ai->CreateArchive( &str);
 
 	tick_t startTime = GetMilliseconds();
 	// If we override the savegame we are running to fetch AREs from, it has already dumped
 	// itself as "ares.blb" into the cache folder. Otherwise, just copy directly.
-	if (!overrideRunning && saveGameAREExtractor.copyRetainedAREs(&str) == GEM_ERROR) {
-		Log(ERROR, "Interface", "Failed to copy ARE files into new save game.");
-		return GEM_ERROR;
+	if (!overrideRunning) {
+		auto retained = new MemoryStream("", nullptr, 0);
+		if (saveGameAREExtractor.copyRetainedAREs(retained) == GEM_ERROR) {
+			delete retained;
+			Log(ERROR, "Interface", "Failed to copy ARE files into new save game.");
+			return GEM_ERROR;
+		}
+		archive.AddRecords(retained);
 	}
 
+	// only read the files here, they are compressed later by the archive writer
 	dir.SetFlags(DirectoryIterator::Files);
 	//.tot and .toh should be saved last, because they are updated when an .are is saved
 	int priority=2;
@@ -3754,18 +3855,29 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 			const path_t& name = dir.GetName();
 			if (SavedExtension(name) == priority) {
 				path_t dtmp = dir.GetFullPath();
+				bool blob = IsBlobSaveItem(dtmp);
+				if (blob && !overrideRunning) {
+					continue;
+				}
+
 				FileStream fs;
 				if (!fs.Open(dtmp)) {
 					Log(ERROR, "Interface", "Failed to open \"{}\".", dtmp);
+					continue;
+				}
+				strpos_t size = fs.Size();
+				void* buffer = malloc(size);
+				if (size && fs.Read(buffer, size) == DataStream::Error) {
+					Log(ERROR, "Interface", "Failed to read \"{}\".", dtmp);
+					free(buffer);
+					continue;
 				}
+				auto contents = new MemoryStream(dtmp, buffer, size);
 
-				if (IsBlobSaveItem(dtmp)) {
-					if (overrideRunning) {
-						saveGameAREExtractor.updateSaveGame(str.GetPos());
-						ai->AddToSaveGameCompressed(&str, &fs);
-					}
+				if (blob) {
+					archive.AddRecords(contents, true);
 				} else {
-					ai->AddToSaveGame(&str, &fs);
+					archive.AddFile(contents);
 				}
 			}
 		} while (++dir);
@@ -3777,7 +3889,7 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 	}
 
 	tick_t endTime = GetMilliseconds();
-	Log(WARNING, "Core", "{} ms (compressing SAV file)", endTime - startTime);
+	Log(WARNING, "Core", "{} ms (collecting SAV file contents)", endTime - startTime);
 	return GEM_OK;
 }
 
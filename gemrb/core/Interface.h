@@ -71,6 +71,7 @@ class Map;
 class MusicMgr;
 class Palette;
 class ProjectileServer;
+class SaveArchiveWriter;
 class SaveGame;
 class SaveGameIterator;
 class ScriptEngine;
@@ -593,7 +594,7 @@ public:
 	/** saves the worldmap object to the destination folder */
 	int WriteWorldMap(const path_t& folder);
 	/** saves the .are and .sto files to the destination folder */
-	int CompressSave(const path_t& folder, bool overrideRunning);
+	int CompressSave(SaveArchiveWriter& archive, bool overrideRunning);
 	/** toggles the pause. returns either PAUSE_ON or PAUSE_OFF to reflect the script state after toggling. */
 	PauseState TogglePause() const;
 	/** returns true the passed pause setting was applied. false otherwise. */
@@ -679,11 +680,15 @@ private:
 	GameControl* StartGameControl();
 	/** Executes everything (non graphical) in the main game loop */
 	void GameLoop(void);
+	/** Headless replacement of the main loop for timing runs, see BenchmarkTicks */
+	void RunBenchmark();
 	/** the internal (without cache) part of GetListFrom2DA */
 	std::vector<ieDword> GetListFrom2DAInternal(const ResRef& resref) const;
 
 public:
 	CoreSettings config;
+	// set by the frontend when it can count heap allocations, reported by the benchmark
+	uint64_t (*AllocationCounter)() = nullptr;
 	ResRef GameNameResRef;
 	ResRef GoldResRef; //MISC07.itm
 	ResRefMap<ItemList> RtRows;
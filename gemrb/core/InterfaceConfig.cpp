@@ -167,13 +167,21 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	CONFIG_INT("DoubleClickDelay", config.DoubleClickDelay);
 	CONFIG_INT("DrawFPS", config.DrawFPS);
 	CONFIG_INT("CapFPS", config.CapFPS);
+	CONFIG_INT("Profiler", config.EnableProfiler);
 	CONFIG_INT("FullScreen", config.FullScreen);
 	CONFIG_INT("EnableCheatKeys", config.CheatFlag);
 	CONFIG_INT("GCDebug", config.DebugFlags);
 	CONFIG_INT("GUIEnhancements", config.GUIEnhancements);
 	CONFIG_INT("Height", config.Height);
 	CONFIG_INT("KeepCache", config.KeepCache);
+	CONFIG_INT("CompiledScriptCache", config.CompiledScriptCache);
 	CONFIG_INT("MaxPartySize", config.MaxPartySize);
+	CONFIG_INT("IdleScriptStride", config.IdleScriptStride);
+	CONFIG_INT("AreaCacheSize", config.AreaCacheSize);
+	CONFIG_INT("SaveCompression", config.SaveCompression);
+	CONFIG_INT("QuickSaveCompression", config.QuickSaveCompression);
+	CONFIG_INT("BenchmarkTicks", config.BenchmarkTicks);
+	CONFIG_INT("BenchmarkSeed", config.BenchmarkSeed);
 	config.MaxPartySize = std::min(std::max(1, config.MaxPartySize), 10);
 	CONFIG_INT("MouseFeedback", config.MouseFeedback);
 	CONFIG_INT("MultipleQuickSaves", config.MultipleQuickSaves);
@@ -181,6 +189,7 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	CONFIG_INT("RepeatKeyDelay", config.ActionRepeatDelay);
 	CONFIG_INT("SaveAsOriginal", config.SaveAsOriginal);
 	CONFIG_INT("SpriteFogOfWar", config.SpriteFoW);
+	CONFIG_INT("RetainedFogOfWar", config.RetainedFoW);
 	CONFIG_INT("DebugMode", config.debugMode);
 	CONFIG_INT("TouchInput", config.TouchInput);
 	CONFIG_INT("Width", config.Width);
@@ -292,6 +301,8 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 
 	CONFIG_STRING("AudioDriver", config.AudioDriverName);
 	CONFIG_STRING("VideoDriver", config.VideoDriverName);
+	CONFIG_STRING("BenchmarkSave", config.BenchmarkSave);
+	CONFIG_STRING("ProfilerCSV", config.ProfilerCSV);
 	CONFIG_STRING("SkipPlugin", config.SkipPlugin);
 	CONFIG_STRING("DelayPlugin", config.DelayPlugin);
 	CONFIG_STRING("Encoding", config.Encoding);
@@ -347,6 +358,11 @@ CoreSettings LoadFromArgs(int argc, char *argv[])
 			settings.Set("FullScreen", "1");
 		} else if (stricmp(argv[i], "--color") == 0) {
 			if (i < argc - 1) settings.Set("LogColor", argv[++i]);
+		} else if (stricmp(argv[i], "--benchmark") == 0) {
+			// headless run of a fixed number of ticks
+			if (i < argc - 1) settings.Set("BenchmarkTicks", argv[++i]);
+			settings.Set("VideoDriver", "none");
+			settings.Set("AudioDriver", "none");
 		} else {
 			// assume a path was passed, soft force configless startup
 			settings.Set("GamePath", argv[i]);
@@ -94,16 +94,27 @@ struct CoreSettings {
 	int Bpp = 32;
 	bool DrawFPS = false;
 	int CapFPS = 0;
+	bool EnableProfiler = false;
+	path_t ProfilerCSV;
 	bool FullScreen = false;
 	bool SpriteFoW = false;
+	bool RetainedFoW = false;
 	uint32_t debugMode = 0;
 	bool Logging = true;
 	int LogColor = -1; // -1 is to automatically determine
 	bool CheatFlag = false; /** Cheats enabled? */
 	int MaxPartySize = 6;
 	int GUIEnhancements = 23;
+	int IdleScriptStride = 4;
+	int AreaCacheSize = 64; // in MB, how much the recently visited areas may use while kept in memory
+	int SaveCompression = 9; // zlib level of the .sav archive, 0-9
+	int QuickSaveCompression = 1; // same for quick saves, which are made often, so favour speed
+	int BenchmarkTicks = 0; // >0 runs that many ticks headless, then quits
+	uint32_t BenchmarkSeed = 1;
+	std::string BenchmarkSave;
 
 	bool KeepCache = false;
+	bool CompiledScriptCache = true;
 	bool MultipleQuickSaves = false;
 	bool UseAsLibrary = false;
 	// once GemRB own format is working well, this might be set to 0
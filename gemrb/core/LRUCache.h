@@ -33,8 +33,14 @@ namespace GemRB {
 
 struct VarEntry;
 
-/* Not thread-safe, PRED is an eviction predicate */
-template<typename T, class PRED>
+/* Default weight: only the number of entries is limited */
+template<typename T>
+struct LRUCacheNoWeight {
+	size_t operator()(const T&) const { return 0; }
+};
+
+/* Not thread-safe, PRED is an eviction predicate, WEIGHT returns the size counted against the budget */
+template<typename T, class PRED, class WEIGHT = LRUCacheNoWeight<T>>
 class LRUCache {
 	public:
 		using key_t = std::string;
@@ -56,6 +62,7 @@ class LRUCache {
 		/* Cache items hold the value and a short cut to the queue item to be moved to the end. */
 		struct CacheItem {
 			QueueItem* queueItem = nullptr;
+			size_t weight = 0;
 			T value;
 
 			template<typename ... ARGS>
@@ -67,11 +74,19 @@ class LRUCache {
 		QueueItem* back = nullptr;
 		std::unordered_map<key_t, CacheItem> map;
 		size_t cacheSize;
+		size_t budget; // 0 means no budget
+		size_t usage = 0;
 		PRED predicate;
+		WEIGHT weigh;
 
 	public:
-		explicit LRUCache(size_t size) : cacheSize(size) {}
+		explicit LRUCache(size_t size, size_t budget = 0) : cacheSize(size), budget(budget) {}
 		~LRUCache () {
+			Clear();
+		}
+
+		/* Drops every entry, without eviction notices */
+		void Clear() {
 			auto next = front;
 
 			while (next != nullptr) {
@@ -79,24 +94,40 @@ class LRUCache {
 				delete next;
 				next = _next;
 			}
+			front = nullptr;
+			back = nullptr;
+			map.clear();
+			usage = 0;
 		}
 
+		/* Returns the resident entry, which is the old one if the key was already cached */
 		template<typename ... ARGS>
-		void SetAt(const public_key_t& key, ARGS && ...args) {
+		const T* SetAt(const public_key_t& key, ARGS && ...args) {
+			T value(std::forward<ARGS>(args)...);
+			auto existing = map.find(key.c_str());
+			if (existing != map.end()) {
+				return &existing->second.value;
+			}
+
+			size_t weight = weigh(value);
 			if (map.size() == cacheSize) {
-				evict();
+				evict(true);
 			}
+			// entries still in use are kept, even if that exceeds the budget
+			while (budget && usage + weight > budget && evict(false)) {}
 
 			auto insertion =
 				map.emplace(
 					std::piecewise_construct,
 					std::forward_as_tuple(key.c_str()),
-					std::forward_as_tuple(std::forward<ARGS>(args)...)
+					std::forward_as_tuple(std::move(value))
 				);
 
 			if (!insertion.second) {
-				return;
+				return nullptr;
 			}
+			insertion.first->second.weight = weight;
+			usage += weight;
 
 			if (back == nullptr) {
 				this->back = new QueueItem(insertion.first->first);
@@ -111,6 +142,7 @@ class LRUCache {
 			}
 
 			insertion.first->second.queueItem = back;
+			return &insertion.first->second.value;
 		}
 
 		const T* Lookup(const public_key_t& key) const {
@@ -139,6 +171,7 @@ class LRUCache {
 			if (lookup != map.cend()) {
 				unlink(lookup->second.queueItem);
 				delete lookup->second.queueItem;
+				usage -= lookup->second.weight;
 				map.erase(lookup);
 
 				return true;
@@ -147,23 +180,30 @@ class LRUCache {
 			return false;
 		}
 
+		size_t Usage() const {
+			return usage;
+		}
+
 	private:
-		void evict() {
+		/* With force, the last entry is evicted even if the predicate rejects all of them */
+		bool evict(bool force) {
 			auto next = front;
 			while (next != nullptr) {
 				auto lookup = map.find(next->key);
 
-				if (next->next == nullptr || predicate(lookup->second.value)) {
+				if ((force && next->next == nullptr) || predicate(lookup->second.value)) {
 					/* This is because OpenAL could have done stuff in predicate. */
 					lookup->second.value.evictionNotice();
 
+					usage -= lookup->second.weight;
 					map.erase(lookup);
 					unlink(next);
 					delete next;
-					break;
+					return true;
 				}
 				next = next->next;
 			}
+			return false;
 		}
 
 		void moveToBack(QueueItem *item) {
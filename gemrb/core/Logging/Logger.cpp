@@ -19,7 +19,9 @@
 #include "Logging/Logger.h"
 
 #include "Logging/Logging.h"
+#include "Platform.h"
 
+#include <chrono>
 #include <cstdio>
 
 namespace GemRB {
@@ -35,32 +37,67 @@ const EnumArray<LogLevel, LOG_FMT> Logger::LevelFormat {
 
 const LOG_FMT Logger::MSG_STYLE = fmt::fg(fmt::color::ghost_white);
 
+static_assert((Logger::QueueSize & (Logger::QueueSize - 1)) == 0, "QueueSize must be a power of two");
+
 Logger::Logger(std::deque<WriterPtr> writers)
-: writers(std::move(writers))
-{}
+: messageQueue(new Slot[QueueSize]), writers(std::move(writers))
+{
+	for (size_t i = 0; i < QueueSize; ++i) {
+		messageQueue[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
 
 Logger::~Logger()
 {
 	running = false;
 	cv.notify_all();
-	if (loggingThread.joinable())
+	if (loggingThread.joinable()) {
 		loggingThread.join();
+	} else if (!writers.empty()) {
+		ProcessMessages();
+	}
 }
 
 void Logger::StartProcessingThread()
 {
 	loggingThread = std::thread([this] {
+		TRACY(tracy::SetThreadName("Logger"));
 		while (running) {
-			QueueType queue;
+			ProcessMessages();
 			std::unique_lock<std::mutex> lk(queueLock);
-			cv.wait(lk, [this]() { return !messageQueue.empty() || !running; });
-			queue.swap(messageQueue);
-			lk.unlock();
-			ProcessMessages(std::move(queue));
+			// producers don't take the lock, so a wakeup can be missed; the timeout covers that
+			cv.wait_for(lk, std::chrono::milliseconds(50), [this]() {
+				size_t pos = dequeuePos & (QueueSize - 1);
+				return messageQueue[pos].sequence.load(std::memory_order_acquire) == dequeuePos + 1 || !running;
+			});
 		}
+		ProcessMessages();
 	});
 }
 
+// slot sequences: equal to the position when free, position + 1 when filled
+bool Logger::Enqueue(LogMessage&& msg)
+{
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	while (true) {
+		Slot& slot = messageQueue[pos & (QueueSize - 1)];
+		size_t seq = slot.sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<ptrdiff_t>(seq - pos);
+		if (diff == 0) {
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				slot.msg = std::move(msg);
+				slot.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			// full, the consumer didn't free this slot yet
+			return false;
+		} else {
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
 void Logger::AddLogWriter(WriterPtr writer)
 {
 	std::lock_guard<std::mutex> l(writerLock);
@@ -72,14 +109,27 @@ void Logger::AddLogWriter(WriterPtr writer)
 	}
 }
 
-void Logger::ProcessMessages(QueueType queue)
+void Logger::ProcessMessages()
 {
 	std::lock_guard<std::mutex> l(writerLock);
-	while (!queue.empty()) {
+	while (true) {
+		Slot& slot = messageQueue[dequeuePos & (QueueSize - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break;
+
 		for (const auto& writer : writers) {
-			writer->WriteLogMessage(queue.front());
+			writer->WriteLogMessage(slot.msg);
+		}
+		slot.msg = LogMessage();
+		slot.sequence.store(dequeuePos + QueueSize, std::memory_order_release);
+		++dequeuePos;
+	}
+
+	size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+	if (lost) {
+		LogMessage msg(WARNING, "Logger", fmt::format("Dropped {} messages, the log queue was full.", lost), MSG_STYLE);
+		for (const auto& writer : writers) {
+			writer->WriteLogMessage(msg);
 		}
-		queue.pop_front();
 	}
 }
 
@@ -96,11 +146,24 @@ void Logger::LogMsg(LogMessage&& msg)
 		for (const auto& writer : writers) {
 			writer->WriteLogMessage(msg);
 		}
+	} else if (Enqueue(std::move(msg))) {
+		cv.notify_one();
 	} else {
-		std::lock_guard<std::mutex> l(queueLock);
-		messageQueue.push_back(std::move(msg));
-		cv.notify_all();
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+LogLevel Logger::MaxWriterLevel()
+{
+	std::lock_guard<std::mutex> l(writerLock);
+	// keep everything until the first writer shows up, it gets the backlog
+	if (writers.empty()) return DEBUG;
+
+	LogLevel level = FATAL;
+	for (const auto& writer : writers) {
+		level = std::max<LogLevel>(level, writer->level);
 	}
+	return level;
 }
 
 void Logger::Flush()
@@ -65,6 +65,7 @@ public:
 		std::string message;
 		LOG_FMT format;
 		
+		LogMessage() noexcept = default;
 		LogMessage(LogLevel level, std::string owner, std::string message, LOG_FMT fmt)
 		: level(level), owner(std::move(owner)), message(std::move(message)), format(fmt) {}
 	};
@@ -85,19 +86,29 @@ public:
 	};
 
 	using WriterPtr = std::shared_ptr<LogWriter>;
+	// messages waiting for the logging thread, anything over it is dropped and counted
+	static constexpr size_t QueueSize = 4096;
 private:
-	using QueueType = std::deque<LogMessage>;
-	QueueType messageQueue;
+	// bounded queue with preallocated slots, so producers never lock or grow it
+	// any thread may log, only the logging thread consumes
+	struct Slot {
+		std::atomic<size_t> sequence { 0 };
+		LogMessage msg;
+	};
+	std::unique_ptr<Slot[]> messageQueue;
+	std::atomic<size_t> enqueuePos { 0 };
+	size_t dequeuePos = 0;
+	std::atomic<size_t> dropped { 0 };
 	std::deque<WriterPtr> writers;
 	
 	std::atomic_bool running {true};
 	std::condition_variable cv;
-	std::mutex queueLock;
+	std::mutex queueLock; // only for waiting on cv
 	std::mutex writerLock;
 	std::thread loggingThread;
 	
-	void threadLoop();
-	void ProcessMessages(QueueType queue);
+	bool Enqueue(LogMessage&& msg);
+	void ProcessMessages();
 	void StartProcessingThread();
 
 public:
@@ -109,6 +120,8 @@ public:
 	void LogMsg(LogLevel, const char* owner, const char* message, LOG_FMT fmt);
 	void LogMsg(LogMessage&& msg);
 	void Flush();
+	/** The highest level any of the writers wants */
+	LogLevel MaxWriterLevel();
 };
 
 }
@@ -39,6 +39,23 @@ using LogMessage = Logger::LogMessage;
 static std::atomic<LogLevel> CWLL;
 static std::deque<Logger::WriterPtr> writers;
 static std::unique_ptr<Logger> logger;
+// the highest level anyone listens to, updated whenever the listeners change
+static std::atomic<LogLevel> activeLevel { DEBUG };
+
+static void UpdateActiveLevel()
+{
+	LogLevel level = CWLL;
+	if (logger) {
+		level = std::max(level, logger->MaxWriterLevel());
+	}
+	activeLevel = level;
+}
+
+bool LogLevelActive(LogLevel level)
+{
+	// INTERNAL messages can't be suppressed
+	return level == INTERNAL || level <= activeLevel.load(std::memory_order_relaxed);
+}
 
 void ToggleLogging(bool enable)
 {
@@ -47,6 +64,7 @@ void ToggleLogging(bool enable)
 	} else if (!enable) {
 		logger = nullptr;
 	}
+	UpdateActiveLevel();
 }
 
 static void ConsoleWinLogMsg(const LogMessage& msg)
@@ -80,6 +98,7 @@ void SetConsoleWindowLogLevel(LogLevel level)
 		ConsoleWinLogMsg(onMsg);
 	}
 	CWLL = level;
+	UpdateActiveLevel();
 }
 
 void LogMsg(LogMessage&& msg)
@@ -94,8 +113,9 @@ void AddLogWriter(Logger::WriterPtr&& writer)
 {
 	writers.push_back(std::move(writer));
 	if (logger) {
-		return logger->AddLogWriter(writers.back());
+		logger->AddLogWriter(writers.back());
 	}
+	UpdateActiveLevel();
 }
 
 void FlushLogs()
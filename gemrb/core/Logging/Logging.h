@@ -41,10 +41,15 @@ GEM_EXPORT void AddLogWriter(Logger::WriterPtr&&);
 GEM_EXPORT void SetConsoleWindowLogLevel(LogLevel level);
 GEM_EXPORT void LogMsg(Logger::LogMessage&& msg);
 GEM_EXPORT void FlushLogs();
+/** Whether any writer or the console would show a message of this level */
+GEM_EXPORT bool LogLevelActive(LogLevel level);
 
 template<typename... ARGS>
 void Log(LogLevel level, const char* owner, const char* message, ARGS&&... args)
 {
+	// don't bother formatting what nobody will see
+	if (!LogLevelActive(level)) return;
+
 	auto formattedMsg = fmt::format(message, std::forward<ARGS>(args)...);
 	LogMsg(Logger::LogMessage(level, owner, std::move(formattedMsg), Logger::MSG_STYLE));
 }
@@ -37,7 +37,9 @@
 #include "Palette.h"
 #include "Particles.h"
 #include "PluginMgr.h"
+#include "Profiler.h"
 #include "Projectile.h"
+#include "ProjectileServer.h"
 #include "SaveGameIterator.h"
 #include "ScriptedAnimation.h"
 #include "TileMap.h"
@@ -45,6 +47,7 @@
 #include "Video/Video.h"
 #include "strrefs.h"
 #include "ie_cursors.h"
+#include "voodooconst.h"
 #include "GameScript/GSUtils.h"
 #include "GUI/GameControl.h"
 #include "GUI/Window.h"
@@ -55,6 +58,7 @@
 
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <limits>
 #include <utility>
 #include <unordered_map>
@@ -449,6 +453,7 @@ ExploredBitmap(FogMapSize(), uint8_t(0x00)), VisibleBitmap(FogMapSize(), uint8_t
 
 Map::~Map(void)
 {
+	InvalidateVariableRefs();
 	//close the current container if it was owned by this map, this avoids a crash
 	const Container *c = core->GetCurrentContainer();
 	if (c && c->GetCurrentArea()==this) {
@@ -494,6 +499,7 @@ Map::~Map(void)
 void Map::SetTileMapProps(TileProps props)
 {
 	tileProps = std::move(props);
+	InvalidateLOSCache();
 }
 	
 const MapReverbProperties& Map::GetReverbProperties() const
@@ -505,6 +511,23 @@ const MapReverbProperties& Map::GetReverbProperties() const
 	return none;
 }
 
+void Map::PrefetchSounds() const
+{
+	auto audio = core->GetAudioDrv();
+	for (const Ambient* ambient : ambients) {
+		for (const ResRef& sound : ambient->sounds) {
+			audio->Prefetch(sound);
+		}
+	}
+
+	size_t doorCount = TMap->GetDoorCount();
+	for (size_t i = 0; i < doorCount; ++i) {
+		const Door* door = TMap->GetDoor(i);
+		audio->Prefetch(door->OpenSound);
+		audio->Prefetch(door->CloseSound);
+	}
+}
+
 void Map::AutoLockDoors() const
 {
 	GetTileMap()->AutoLockDoors();
@@ -670,6 +693,8 @@ void Map::DrawPortal(const InfoPoint *ip, int enable)
 
 void Map::UpdateScripts()
 {
+	if (Dormant) return;
+
 	bool has_pcs = false;
 	for (const auto& actor : actors) {
 		if (actor->InParty) {
@@ -723,6 +748,7 @@ void Map::UpdateScripts()
 	}
 	
 	ieDword time = game->Ticks; // make sure everything moves at the same time
+	bool partyInCombat = game->AnyPCInCombat();
 
 	//Run actor scripts (only for 0 priority)
 	const auto& runQueue = queue[int(Priority::RunScripts)];
@@ -768,7 +794,16 @@ void Map::UpdateScripts()
 		 * point, etc), but i did it this way for now because it seems least painful
 		 * and we should probably be staggering the script executions anyway (we do)
 		 */
+		actor->ScriptStride = GetScriptStride(actor, partyInCombat);
+		ieDword evaluations = actor->ScriptEvaluations;
+		auto start = std::chrono::steady_clock::now();
 		actor->Update();
+		uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		scriptStats.micros += micros;
+		scriptStats.evaluations += actor->ScriptEvaluations - evaluations;
+		scriptTotals.micros += micros;
+		scriptTotals.evaluations += actor->ScriptEvaluations - evaluations;
+
 		actor->UpdateActorState();
 		actor->SetSpeed(false);
 		
@@ -790,6 +825,19 @@ void Map::UpdateScripts()
 		}
 	}
 
+	tick_t now = GetMilliseconds();
+	if (now - scriptStatsStart >= 1000) {
+		if (scriptStatsStart) {
+			lastScriptStats = scriptStats;
+			if (InDebugMode(DebugMode::SCRIPTSTATS)) {
+				Log(DEBUG, "Map", "{}: {} actor script evaluations, {}us of actor updates in {}ms",
+					GetScriptRef(), scriptStats.evaluations, scriptStats.micros, now - scriptStatsStart);
+			}
+		}
+		scriptStats = {};
+		scriptStatsStart = now;
+	}
+
 	//clean up effects on dead actors too
 	const auto& displayQueue = queue[int(Priority::Display)];
 	q = displayQueue.size();
@@ -809,6 +857,8 @@ void Map::UpdateScripts()
 	}
 
 	//Check if we need to start some trap scripts
+	UpdateInfoPointGrid();
+	FindActorsNearInfoPoints(runQueue);
 	int ipCount = 0;
 	while (true) {
 		//For each InfoPoint in the map
@@ -831,8 +881,21 @@ void Map::UpdateScripts()
 			continue;
 		}
 
-		const auto& runQueue = queue[int(Priority::RunScripts)];
-		q = runQueue.size();
+		if (ip->Type == ST_PROXIMITY && size_t(ipCount) <= ipGrid.nearby.size()) {
+			// only the actors near enough can trigger it, visited in the same order as the full queue
+			const auto& nearby = ipGrid.nearby[ipCount - 1];
+			for (auto it = nearby.rbegin(); it != nearby.rend(); ++it) {
+				Actor* actor = runQueue[*it];
+				if (ip->Entered(actor)) {
+					// if trap triggered, then mark actor
+					actor->SetInTrap(ipCount);
+					wasActive |= _TRAP_USEPOINT;
+				}
+			}
+			q = 0;
+		} else {
+			q = runQueue.size();
+		}
 		ieDword exitID = ip->GetGlobalID();
 		while (q--) {
 			Actor* actor = runQueue[q];
@@ -874,6 +937,102 @@ void Map::UpdateScripts()
 	SortQueues();
 }
 
+static constexpr int InfoPointCellSize = 256;
+
+// everything InfoPoint::Entered accepts for proximity traps, save for the actor size
+static Region ProximityReach(const InfoPoint* ip)
+{
+	Region reach;
+	bool found = false;
+	if (ip->outline) {
+		reach = ip->outline->BBox;
+		found = true;
+	} else if (!ip->BBox.size.IsInvalid()) {
+		reach = ip->BBox;
+		found = true;
+	}
+	if (!ip->UsePoint.IsInvalid()) {
+		int range = int(MAX_OPERATING_DISTANCE);
+		Region useRange(ip->UsePoint - Point(range, range), Size(range * 2, range * 2));
+		if (found) {
+			reach.ExpandToRegion(useRange);
+		} else {
+			reach = useRange;
+			found = true;
+		}
+	}
+	if (found) {
+		// leave room for the rounding in the checks
+		reach.ExpandAllSides(1);
+	}
+	return reach;
+}
+
+void Map::UpdateInfoPointGrid()
+{
+	const auto& infoPoints = TMap->GetInfoPoints();
+	if (ipGrid.built && ipGrid.infoPoints == infoPoints.size()) {
+		return;
+	}
+
+	Size mapSize = GetSize();
+	ipGrid.columns = std::max(mapSize.w, 0) / InfoPointCellSize + 1;
+	ipGrid.rows = std::max(mapSize.h, 0) / InfoPointCellSize + 1;
+	ipGrid.cells.assign(size_t(ipGrid.columns * ipGrid.rows), {});
+	ipGrid.reach.assign(infoPoints.size(), Region());
+	for (size_t idx = 0; idx < infoPoints.size(); ++idx) {
+		const InfoPoint* ip = infoPoints[idx];
+		if (ip->Type != ST_PROXIMITY) continue;
+
+		const Region reach = ProximityReach(ip);
+		if (reach.size.IsInvalid()) continue;
+		ipGrid.reach[idx] = reach;
+
+		int left = Clamp(reach.x / InfoPointCellSize, 0, ipGrid.columns - 1);
+		int right = Clamp((reach.x + reach.w) / InfoPointCellSize, 0, ipGrid.columns - 1);
+		int top = Clamp(reach.y / InfoPointCellSize, 0, ipGrid.rows - 1);
+		int bottom = Clamp((reach.y + reach.h) / InfoPointCellSize, 0, ipGrid.rows - 1);
+		for (int y = top; y <= bottom; ++y) {
+			for (int x = left; x <= right; ++x) {
+				ipGrid.cells[y * ipGrid.columns + x].push_back(idx);
+			}
+		}
+	}
+	ipGrid.infoPoints = infoPoints.size();
+	ipGrid.built = true;
+}
+
+void Map::FindActorsNearInfoPoints(const std::vector<Actor*>& actors)
+{
+	ipGrid.nearby.resize(ipGrid.reach.size());
+	for (auto& nearby : ipGrid.nearby) {
+		nearby.clear();
+	}
+
+	for (size_t q = 0; q < actors.size(); ++q) {
+		const Actor* actor = actors[q];
+		// PersonalDistance subtracts this from the distance
+		int radius = actor->CircleSize2Radius() * 4;
+		Region box(actor->Pos - Point(radius, radius), Size(radius * 2 + 1, radius * 2 + 1));
+
+		int left = Clamp(box.x / InfoPointCellSize, 0, ipGrid.columns - 1);
+		int right = Clamp((box.x + box.w) / InfoPointCellSize, 0, ipGrid.columns - 1);
+		int top = Clamp(box.y / InfoPointCellSize, 0, ipGrid.rows - 1);
+		int bottom = Clamp((box.y + box.h) / InfoPointCellSize, 0, ipGrid.rows - 1);
+		for (int y = top; y <= bottom; ++y) {
+			for (int x = left; x <= right; ++x) {
+				for (size_t idx : ipGrid.cells[y * ipGrid.columns + x]) {
+					auto& nearby = ipGrid.nearby[idx];
+					if (!nearby.empty() && nearby.back() == q) continue;
+					if (ipGrid.reach[idx].IntersectsRegion(box)) {
+						nearby.push_back(q);
+					}
+				}
+			}
+		}
+	}
+}
+
 ResRef Map::ResolveTerrainSound(const ResRef& resref, const Point &p) const
 {
 	struct TerrainSounds {
@@ -951,6 +1110,22 @@ Size Map::PropsSize() const noexcept
 	return tileProps.GetSize();
 }
 
+size_t Map::ResidentFootprint() const
+{
+	// the pixel data is mirrored by the textures, which we can't query, so count it once
+	size_t bytes = TMap->ResidentBytes();
+	Size propsSize = PropsSize();
+	bytes += size_t(propsSize.w) * propsSize.h * 4;
+	if (SmallMap) bytes += SmallMap->Bytes();
+	if (Background) bytes += Background->Bytes();
+	for (const auto& tile : wallStencilTiles) {
+		if (tile.buffer) bytes += size_t(tile.buffer->Size().Area()) * 4;
+	}
+	bytes += ExploredBitmap.Bytes() + VisibleBitmap.Bytes();
+	bytes += actors.size() * sizeof(Actor);
+	return bytes;
+}
+
 // Returns true if map at (x;y) was explored, else false.
 bool Map::FogTileUncovered(const Point &p, const Bitmap* mask) const
 {
@@ -1180,8 +1355,7 @@ void Map::DrawMap(const Region& viewport, FogRenderer& fogRenderer, uint32_t dFl
 	// draw reticles before actors
 	core->GetGameControl()->DrawTargetReticles();
 
-	const auto& viewportWalls = WallsIntersectingRegion(viewport, false);
-	RedrawScreenStencil(viewport, viewportWalls.first);
+	RedrawScreenStencil(viewport);
 	VideoDriver->SetStencilBuffer(wallStencil);
 	
 	//draw all background animations first
@@ -1495,32 +1669,38 @@ void Map::SetDrawingStencilForObject(const void* object, const Region& objectRgn
 
 	if (behindWall && inFrontOfWall) {
 		// we need a custom stencil if both behind and in front of a wall
-		auto it = objectStencils.find(object);
-		if (it != objectStencils.end()) {
-			// we already made one
-			const auto& pair = it->second;
-			if (pair.second.RectInside(objectRgn)) {
-				// and it is still good
-				stencil = pair.first;
-			}
+		size_t wallsHash = walls.first.size();
+		for (const auto& wp : walls.first) {
+			wallsHash = wallsHash * 31 + std::hash<const Wall_Polygon*>()(wp.get());
 		}
-		
-		if (stencil == nullptr) {
+
+		ObjectStencil& cached = objectStencils[object];
+		if (cached.buffer && cached.region.RectInside(objectRgn)) {
+			// we already made one and it is still big enough
+			// but redraw it only if the walls over us or their door state changed
+			stencil = cached.buffer;
+			stencil->SetOrigin(objectRgn.origin - viewPortOrigin);
+			if (cached.drawnRegion != objectRgn || cached.wallsHash != wallsHash || cached.version != wallStencilVersion) {
+				stencil->Clear();
+				DrawStencil(stencil, objectRgn, walls.first);
+			}
+		} else {
 			Region stencilRgn = Region(objectRgn.origin - viewPortOrigin, objectRgn.size);
 			if (stencilRgn.size.IsInvalid()) {
+				objectStencils.erase(object);
 				stencil = wallStencil;
 			} else {
 				stencil = VideoDriver->CreateBuffer(stencilRgn, Video::BufferFormat::DISPLAY_ALPHA);
 				DrawStencil(stencil, objectRgn, walls.first);
-				objectStencils[object] = std::make_pair(stencil, objectRgn);
+				cached.buffer = stencil;
+				cached.region = objectRgn;
 			}
-		} else {
-			// TODO: we only need to do this because a door might have changed state over us
-			// if we could detect that we could avoid doing this expensive operation
-			// we could add another wall flag to mark doors and then we only need to do this if one of the "walls" over us has that flag set
-			stencil->Clear();
-			stencil->SetOrigin(objectRgn.origin - viewPortOrigin);
-			DrawStencil(stencil, objectRgn, walls.first);
+		}
+
+		if (stencil != wallStencil) {
+			cached.drawnRegion = objectRgn;
+			cached.wallsHash = wallsHash;
+			cached.version = wallStencilVersion;
 		}
 		
 		debugColor = ColorRed;
@@ -1757,20 +1937,16 @@ void Map::DrawDebugOverlay(const Region &vp, uint32_t dFlags) const
 		// draw also pathfinding waypoints
 		const Actor *act = core->GetFirstSelectedActor();
 		if (!act) return;
-		const PathListNode *path = act->GetPath();
-		if (!path) return;
-		const PathListNode *step = path->Next;
+		const Path& path = act->GetPath();
 		Color waypoint(0, 64, 128, 128); // darker blue-ish
-		int i = 0;
 		block.w = 8;
 		block.h = 6;
-		while (step) {
-			block.x = (step->point.x+64) - vp.x;
-			block.y = (step->point.y+6) - vp.y;
-			Log(DEBUG, "Map", "Waypoint {} at {}", i, step->point);
+		for (size_t i = 1; i < path.size(); i++) {
+			const PathNode& step = path[i];
+			block.x = (step.point.x+64) - vp.x;
+			block.y = (step.point.y+6) - vp.y;
+			Log(DEBUG, "Map", "Waypoint {} at {}", i - 1, step.point);
 			VideoDriver->DrawRect(block, waypoint);
-			step = step->Next;
-			i++;
 		}
 	}
 }
@@ -1796,12 +1972,13 @@ void Map::UpdateEffects()
 
 void Map::UpdateProjectiles()
 {
+	PROFILE_ZONE(Projectiles);
 	for (auto it = projectiles.begin(); it != projectiles.end(); ) {
 		(*it)->Update();
 		if ((*it)->IsStillIntact()) {
 			++it;
 		} else {
-			delete *it;
+			core->GetProjectileServer()->Recycle(*it);
 			it = projectiles.erase(it);
 		}
 	}
@@ -2597,6 +2774,34 @@ bool Map::IsVisibleLOS(const Point &s, const Point &d, const Actor *caller) cons
 	return !bool(ret & PathMapFlags::SIDEWALL);
 }
 
+// script object matching and See/Range style triggers ask the same questions for
+// every creature script each round, so remember the answers until the next tick
+// actors don't obstruct LOS, so only positions and door states matter
+bool Map::IsVisibleLOS(const Scriptable* source, const Scriptable* target) const
+{
+	ScriptID sourceID = source->GetGlobalID();
+	ScriptID targetID = target->GetGlobalID();
+	if (!sourceID || !targetID) {
+		return IsVisibleLOS(source->Pos, target->Pos);
+	}
+
+	const Game* game = core->GetGame();
+	if (game && game->GameTime != losCacheTime) {
+		losCache.clear();
+		losCacheTime = game->GameTime;
+	}
+
+	uint64_t key = (uint64_t(sourceID) << 32) | targetID;
+	auto it = losCache.find(key);
+	if (it != losCache.end() && it->second.source == source->Pos && it->second.target == target->Pos) {
+		return it->second.visible;
+	}
+
+	bool visible = IsVisibleLOS(source->Pos, target->Pos);
+	losCache[key] = { source->Pos, target->Pos, visible };
+	return visible;
+}
+
 // Used by the pathfinder, so PathMapFlags::IMPASSABLE obstructs walkability
 bool Map::IsWalkableTo(const Point &s, const Point &d, bool actorsAreBlocking, const Actor *caller) const
 {
@@ -2605,18 +2810,24 @@ bool Map::IsWalkableTo(const Point &s, const Point &d, bool actorsAreBlocking, c
 	return bool(ret & mask);
 }
 
-void Map::RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls)
+void Map::RedrawScreenStencil(const Region& vp)
 {
-	// FIXME: how do we know if a door changed state?
-	// we need to redraw the stencil when that happens
-	// see TODO in Map::SetDrawingStencilForScriptable for another example of something that could use this
+	// the driver lost the buffer contents, so redraw all of them
+	if (wallStencilGeneration != VideoDriver->BufferGeneration()) {
+		wallStencilGeneration = VideoDriver->BufferGeneration();
+		for (auto& tile : wallStencilTiles) {
+			tile.dirty = true;
+		}
+		++wallStencilVersion;
+	}
 
-	if (stencilViewport == vp) {
+	if (stencilViewport == vp && stencilViewportVersion == wallStencilVersion) {
 		assert(wallStencil);
 		return;
 	}
 
 	stencilViewport = vp;
+	stencilViewportVersion = wallStencilVersion;
 
 	if (wallStencil == NULL) {
 		// FIXME: this should be forced 8bit*4 color format
@@ -2627,7 +2838,86 @@ void Map::RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls)
 
 	wallStencil->Clear();
 
-	DrawStencil(wallStencil, vp, walls);
+	DrawStencilFromTiles(wallStencil, vp);
+}
+
+// size of the cached wall stencil tiles, in area pixels
+static constexpr uint32_t wallStencilTileSize = 512;
+
+void Map::InvalidateWallStencil(const Region& rgn)
+{
+	++wallStencilVersion;
+
+	if (wallStencilTiles.empty()) return;
+
+	uint32_t pitch = CeilDiv<uint32_t>(TMap->XCellCount * 64, wallStencilTileSize);
+	uint32_t rows = CeilDiv<uint32_t>(TMap->YCellCount * 64, wallStencilTileSize);
+	uint32_t xmin = std::max(rgn.x, 0) / wallStencilTileSize;
+	uint32_t ymin = std::max(rgn.y, 0) / wallStencilTileSize;
+	uint32_t xmax = std::min(pitch, CeilDiv<uint32_t>(std::max(rgn.x + rgn.w, 0), wallStencilTileSize));
+	uint32_t ymax = std::min(rows, CeilDiv<uint32_t>(std::max(rgn.y + rgn.h, 0), wallStencilTileSize));
+
+	for (uint32_t y = ymin; y < ymax; ++y) {
+		for (uint32_t x = xmin; x < xmax; ++x) {
+			wallStencilTiles[y * pitch + x].dirty = true;
+		}
+	}
+}
+
+const VideoBufferPtr& Map::GetWallStencilTile(uint32_t x, uint32_t y)
+{
+	uint32_t pitch = CeilDiv<uint32_t>(TMap->XCellCount * 64, wallStencilTileSize);
+	if (wallStencilTiles.empty()) {
+		uint32_t rows = CeilDiv<uint32_t>(TMap->YCellCount * 64, wallStencilTileSize);
+		wallStencilTiles.resize(pitch * rows);
+	}
+
+	WallStencilTile& tile = wallStencilTiles[y * pitch + x];
+	if (!tile.dirty) {
+		return tile.buffer;
+	}
+	tile.dirty = false;
+
+	Region tileRgn(x * wallStencilTileSize, y * wallStencilTileSize, wallStencilTileSize, wallStencilTileSize);
+	const auto& walls = WallsIntersectingRegion(tileRgn, false);
+	if (walls.first.empty()) {
+		// nothing to cover, don't waste a buffer
+		tile.buffer = nullptr;
+		return tile.buffer;
+	}
+
+	if (!tile.buffer) {
+		tile.buffer = VideoDriver->CreateBuffer(Region(Point(), tileRgn.size), Video::BufferFormat::DISPLAY_ALPHA);
+	}
+	tile.buffer->Clear();
+	DrawStencil(tile.buffer, tileRgn, walls.first);
+	return tile.buffer;
+}
+
+// copies the cached tile stencils overlapping rgn (in area coordinates) to stencilBuffer
+void Map::DrawStencilFromTiles(const VideoBufferPtr& stencilBuffer, const Region& rgn)
+{
+	uint32_t pitch = CeilDiv<uint32_t>(TMap->XCellCount * 64, wallStencilTileSize);
+	uint32_t rows = CeilDiv<uint32_t>(TMap->YCellCount * 64, wallStencilTileSize);
+	uint32_t xmin = std::max(rgn.x, 0) / wallStencilTileSize;
+	uint32_t ymin = std::max(rgn.y, 0) / wallStencilTileSize;
+	uint32_t xmax = std::min(pitch, CeilDiv<uint32_t>(std::max(rgn.x + rgn.w, 0), wallStencilTileSize));
+	uint32_t ymax = std::min(rows, CeilDiv<uint32_t>(std::max(rgn.y + rgn.h, 0), wallStencilTileSize));
+
+	for (uint32_t y = ymin; y < ymax; ++y) {
+		for (uint32_t x = xmin; x < xmax; ++x) {
+			// fetch the tile before pushing the target, since redrawing a tile pushes its own buffer
+			const VideoBufferPtr& tile = GetWallStencilTile(x, y);
+			if (!tile) continue;
+
+			Point tileOrigin(x * wallStencilTileSize, y * wallStencilTileSize);
+			VideoDriver->PushDrawingBuffer(stencilBuffer);
+			// no blending, the tiles don't overlap, so this is a plain copy
+			// the channels are stencil values, not colors, so they mustn't be corrected either
+			VideoDriver->BlitVideoBuffer(tile, tileOrigin - rgn.origin, BlitFlags::NO_GAMMA);
+			VideoDriver->PopDrawingBuffer();
+		}
+	}
 }
 
 void Map::DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const
@@ -2708,6 +2998,19 @@ Priority Map::SetPriority(Actor* actor, bool& hostilesNew, ieDword gameTime) con
 	return priority;
 }
 
+// actors the party can interact with get their scripts run every 16 ticks,
+// while the others only check every 16 * IdleScriptStride ticks
+ieDword Map::GetScriptStride(const Actor* actor, bool partyInCombat) const
+{
+	if (actor->InParty || partyInCombat || actor->objects.LastTarget) {
+		return 1;
+	}
+	if (IsVisible(actor->Pos)) {
+		return 1;
+	}
+	return ieDword(std::max(core->config.IdleScriptStride, 1));
+}
+
 //this function determines actor drawing order
 //it should be extended to wallgroups, animations, effects!
 void Map::GenerateQueues()
@@ -3164,6 +3467,7 @@ const MapNote* Map::MapNoteAtPoint(const Point& point, unsigned int radius) cons
 //--------spawning------------------
 void Map::LoadIniSpawn()
 {
+	delete INISpawn;
 	if (core->HasFeature(GFFlags::RESDATA_INI)) {
 		// 85 cases where we'd miss the ini and 1 where we'd use the wrong one
 		INISpawn = new IniSpawn(this, ResRef(scriptName));
@@ -3434,7 +3738,7 @@ void Map::ExploreMapChunk(const Point &Pos, int range, int los)
 
 void Map::UpdateFog()
 {
-	TRACY(ZoneScoped);
+	PROFILE_ZONE(Fog);
 	VisibleBitmap.fill(0);
 	
 	std::set<Spawn*> potentialSpawns;
@@ -50,7 +50,6 @@ class GameControl;
 class IniSpawn;
 class Palette;
 class Particles;
-struct PathListNode;
 class Projectile;
 class ScriptedAnimation;
 class TileMap;
@@ -379,12 +378,24 @@ public:
 	bool MasterArea;
 	//this is set by the importer (not stored in the file)
 	bool DayNight = false;
+	// kept in memory after the party left, but not updated until it returns
+	bool Dormant = false;
+	// game time of the last party visit, so the oldest dormant maps get swapped out first
+	ieDword LastVisit = 0;
+	// ResidentFootprint when the map went dormant, so the budget check needn't redo it
+	size_t DormantFootprint = 0;
 	//movies for day/night (only in ToB)
 	ResRef Dream[2];
 	Holder<Sprite2D> Background = nullptr;
 	ieDword BgDuration = 0;
 	ieDword LastGoCloser = 0;
 
+	// actor script evaluations and the time spent on actor updates, see GetScriptStats
+	struct ScriptStats {
+		ieDword evaluations = 0;
+		uint64_t micros = 0;
+	};
+
 private:
 	uint32_t debugFlags = 0;
 	TrackingData tracking;
@@ -401,12 +412,57 @@ private:
 	std::vector< Spawn*> spawns;
 	std::vector<Actor*> queue[int(Priority::Ignore)];
 	EnumArray<Priority, unsigned int> lastActorCount;
+	// proximity traps bucketed by the cells they can be triggered from
+	struct InfoPointGrid {
+		bool built = false;
+		size_t infoPoints = 0;
+		int columns = 0;
+		int rows = 0;
+		std::vector<Region> reach; // by infopoint index, empty for other types
+		std::vector<std::vector<size_t>> cells;
+		// queue positions of the actors near each infopoint, updated every tick
+		std::vector<std::vector<size_t>> nearby;
+	} ipGrid;
 	bool hostilesVisible = false;
+	ScriptStats scriptStats;
+	ScriptStats lastScriptStats;
+	ScriptStats scriptTotals;
+	tick_t scriptStatsStart = 0;
 
 	VideoBufferPtr wallStencil = nullptr;
 	Region stencilViewport;
+	uint32_t stencilViewportVersion = 0;
 
-	std::unordered_map<const void*, std::pair<VideoBufferPtr, Region>> objectStencils;
+	// the enabled walls rasterized once into fixed size tiles covering the whole area
+	// tiles are created lazily and redrawn only if a door toggled walls over them
+	struct WallStencilTile {
+		VideoBufferPtr buffer;
+		bool dirty = true;
+	};
+	std::vector<WallStencilTile> wallStencilTiles;
+	// bumped whenever the enabled wall set changes, so dependent stencils know to redraw
+	uint32_t wallStencilVersion = 0;
+	// the video buffer generation the stencil tiles were drawn in
+	uint32_t wallStencilGeneration = 0;
+
+	struct ObjectStencil {
+		VideoBufferPtr buffer;
+		Region region;
+		Region drawnRegion;
+		size_t wallsHash = 0;
+		uint32_t version = 0;
+	};
+	std::unordered_map<const void*, ObjectStencil> objectStencils;
+
+	// line of sight between scriptable pairs, reset every game tick
+	// entries remember the positions they were computed for, so movement is handled too
+	struct LOSCacheEntry {
+		Point source;
+		Point target;
+		bool visible = false;
+	};
+	mutable std::unordered_map<uint64_t, LOSCacheEntry> losCache;
+	mutable ieDword losCacheTime = 0;
 
 	class MapReverb {
 	public:
@@ -456,6 +512,12 @@ public:
 	void SetTileMapProps(TileProps props);
 	void AutoLockDoors() const;
 	void UpdateScripts();
+	/* memory held by the graphics, maps and actors of the area while loaded */
+	size_t ResidentFootprint() const;
+	/* actor script evaluations and the time spent on actor updates, over the last second */
+	const ScriptStats& GetScriptStats() const { return lastScriptStats; }
+	// the same, but summed up since the area was loaded
+	const ScriptStats& GetScriptTotals() const { return scriptTotals; }
 	ResRef ResolveTerrainSound(const ResRef &sound, const Point &pos) const;
 	void DoStepForActor(Actor *actor, ieDword time) const;
 	void UpdateEffects();
@@ -599,22 +661,28 @@ public:
 	/* Finds the nearest passable point */
 	void AdjustPosition(Point& goal, const Size& startingRadius = ZeroSize, int size = -1) const;
 	void AdjustPositionNavmap(Point& goal, const Size& radius = ZeroSize) const;
+	/* The path finders below fill path in place, so its storage can be reused; it is left empty on failure */
 	/* Finds the path which leads the farthest from d */
-	PathListNode* RunAway(const Point& s, const Point& d, int maxPathLength, bool backAway, const Actor* caller) const;
-	PathListNode* RandomWalk(const Point &s, int size, int radius, const Actor *caller) const;
+	void RunAway(Path& path, const Point& s, const Point& d, int maxPathLength, bool backAway, const Actor* caller) const;
+	void RandomWalk(Path& path, const Point &s, int size, int radius, const Actor *caller) const;
 	/* returns true if there is enemy visible */
 	bool AnyPCSeesEnemy() const;
 	/* Finds straight path from s, length l and orientation o, f=1 passes wall, f=2 rebounds from wall*/
-	PathListNode* GetLine(const Point &start, int steps, orient_t orient) const;
-	PathListNode* GetLine(const Point &start, int Steps, orient_t Orientation, int flags) const;
-	PathListNode* GetLine(const Point &start, const Point &dest, int speed, orient_t Orientation, int flags) const;
+	void GetLine(Path& path, const Point &start, int steps, orient_t orient) const;
+	Path GetLine(const Point &start, int Steps, orient_t Orientation, int flags) const;
 	Path GetLinePath(const Point &start, const Point &dest, int speed, orient_t Orientation, int flags) const;
 	/* Finds the path which leads to near d */
-	PathListNode* FindPath(const Point &s, const Point &d, unsigned int size, unsigned int minDistance = 0, int flags = PF_SIGHT, const Actor *caller = NULL) const;
+	void FindPath(Path& path, const Point &s, const Point &d, unsigned int size, unsigned int minDistance = 0, int flags = PF_SIGHT, const Actor *caller = NULL) const;
 
 	bool IsVisible(const Point &p) const;
 	bool IsExplored(const Point &p) const;
 	bool IsVisibleLOS(const Point &s, const Point &d, const Actor *caller = NULL) const;
+	/* same as above, but memoized per tick for the (source, target) pair */
+	bool IsVisibleLOS(const Scriptable* source, const Scriptable* target) const;
+	/* needs to be called whenever something that blocks sight changes (doors) */
+	void InvalidateLOSCache() const { losCache.clear(); }
+	/* marks the cached wall stencils covering rgn for redrawing (doors) */
+	void InvalidateWallStencil(const Region& rgn);
 	bool IsWalkableTo(const Point &s, const Point &d, bool actorsAreBlocking, const Actor *caller) const;
 
 	/* returns edge direction of map boundary, only worldmap regions */
@@ -625,6 +693,8 @@ public:
 	void SetupAmbients() const;
 	const std::vector<Ambient *> &GetAmbients() const { return ambients; };
 	const MapReverbProperties& GetReverbProperties() const;
+	/* starts decoding the door and ambient sounds in the background */
+	void PrefetchSounds() const;
 
 	//mapnotes
 	void AddMapNote(const Point &point, ieWord color, String text, bool readonly = false);
@@ -674,8 +744,10 @@ private:
 	Actor *GetNextActor(int &q, size_t &index) const;
 	Container* GetNextPile (size_t& index) const;
 
-	void RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls);
+	void RedrawScreenStencil(const Region& vp);
 	void DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const;
+	const VideoBufferPtr& GetWallStencilTile(uint32_t x, uint32_t y);
+	void DrawStencilFromTiles(const VideoBufferPtr& stencilBuffer, const Region& rgn);
 	WallPolygonSet WallsIntersectingRegion(Region, bool includeDisabled = false, const Point* loc = nullptr) const;
 
 	void SetDrawingStencilForObject(const void*, const Region&, const WallPolygonSet&, const Point& viewPortOrigin);
@@ -697,7 +769,10 @@ private:
 
 	void GenerateQueues();
 	void SortQueues();
+	void UpdateInfoPointGrid();
+	void FindActorsNearInfoPoints(const std::vector<Actor*>& actors);
 	Priority SetPriority(Actor* actor, bool& hostilesNew, ieDword gameTime) const;
+	ieDword GetScriptStride(const Actor* actor, bool partyInCombat) const;
 	//Actor* GetRoot(int priority, int &index);
 	void DeleteActor(size_t idx);
 	//actor uses travel region
@@ -168,6 +168,8 @@ void Particles::Draw(Point p)
 	if (owner) {
 		p -= pos.origin;
 	}
+	// everything but the bitmaps goes into one batch, submitted at the end
+	batch.Clear();
 	ieWord i = size;
 	while (i--) {
 		if (points[i].state == -1) {
@@ -227,21 +229,22 @@ void Particles::Draw(Point p)
 			}
 			break;
 		case SP_TYPE_CIRCLE:
-			VideoDriver->DrawCircle (points[i].pos - p, 2, clr);
+			batch.AddCircle(points[i].pos - p, 2, clr);
 			break;
 		case SP_TYPE_POINT:
 		default:
-			VideoDriver->DrawPoint(points[i].pos - p, clr);
+			batch.AddPoint(points[i].pos - p, clr);
 			break;
 		// this is more like a raindrop
 		case SP_TYPE_LINE:
 			if (length) {
 				int y = length > 3 ? i & 1 : 0;
-				VideoDriver->DrawLine(points[i].pos - p, points[i].pos - p + Point(y, length), clr);
+				batch.AddLine(points[i].pos - p, points[i].pos - p + Point(y, length), clr);
 			}
 			break;
 		}
 	}
+	VideoDriver->DrawPrimitives(batch);
 }
 
 void Particles::AddParticles(int count)
@@ -33,6 +33,7 @@
 #include "ie_types.h"
 
 #include "Region.h"
+#include "Video/Video.h"
 
 #include <memory>
 
@@ -125,6 +126,7 @@ public:
 	int GetHeight() const { return pos.y+pos.h; }
 private:
 	std::vector<Element> points;
+	PrimitiveBatch batch; // rebuilt on every Draw
 	ieDword timetolive = 0;
 	tick_t lastUpdate = 0;
 //	ieDword target;    //could be 0, in that case target is pos
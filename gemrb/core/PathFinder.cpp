@@ -39,9 +39,11 @@
 #include "GameData.h"
 #include "Map.h"
 #include "PathFinder.h"
+#include "Profiler.h"
 #include "RNG.h"
 #include "Scriptable/Actor.h"
 
+#include <algorithm>
 #include <array>
 #include <limits>
 
@@ -59,16 +61,17 @@ constexpr std::array<float_t, RAND_DEGREES_OF_FREEDOM> dxRand{{0.000, -0.383, -0
 constexpr std::array<float_t, RAND_DEGREES_OF_FREEDOM> dyRand{{1.000, 0.924, 0.707, 0.383, 0.000, -0.383, -0.707, -0.924, -1.000, -0.924, -0.707, -0.383, 0.000, 0.383, 0.707, 0.924}};
 
 // Find the best path of limited length that brings us the farthest from d
-PathListNode* Map::RunAway(const Point& s, const Point& d, int maxPathLength, bool backAway, const Actor* caller) const
+void Map::RunAway(Path& path, const Point& s, const Point& d, int maxPathLength, bool backAway, const Actor* caller) const
 {
-	if (!caller || !caller->GetSpeed()) return nullptr;
+	path.clear();
+	if (!caller || !caller->GetSpeed()) return;
 	Point p = s;
 	float_t dx = s.x - d.x;
 	float_t dy = s.y - d.y;
 	char xSign = 1, ySign = 1;
 	size_t tries = 0;
 	NormalizeDeltas(dx, dy, float_t(gamedata->GetStepTime()) / caller->GetSpeed());
-	if (std::abs(dx) <= 0.333 && std::abs(dy) <= 0.333) return nullptr;
+	if (std::abs(dx) <= 0.333 && std::abs(dy) <= 0.333) return;
 	while (SquaredDistance(p, s) < unsigned(maxPathLength * maxPathLength * SEARCHMAP_SQUARE_DIAGONAL * SEARCHMAP_SQUARE_DIAGONAL)) {
 		Point rad(std::lround(p.x + 3 * xSign * dx), std::lround(p.y + 3 * ySign * dy));
 		if (!(GetBlockedInRadius(rad, caller->circleSize) & PathMapFlags::PASSABLE)) {
@@ -86,12 +89,13 @@ PathListNode* Map::RunAway(const Point& s, const Point& d, int maxPathLength, bo
 	}
 	int flags = PF_SIGHT;
 	if (backAway) flags |= PF_BACKAWAY;
-	return FindPath(s, p, caller->circleSize, caller->circleSize, flags, caller);
+	FindPath(path, s, p, caller->circleSize, caller->circleSize, flags, caller);
 }
 
-PathListNode *Map::RandomWalk(const Point &s, int size, int radius, const Actor *caller) const
+void Map::RandomWalk(Path& path, const Point &s, int size, int radius, const Actor *caller) const
 {
-	if (!caller || !caller->GetSpeed()) return nullptr;
+	path.clear();
+	if (!caller || !caller->GetSpeed()) return;
 	NavmapPoint p = s;
 	size_t i = RAND<size_t>(0, RAND_DEGREES_OF_FREEDOM - 1);
 	float_t dx = 3 * dxRand[i];
@@ -104,7 +108,7 @@ PathListNode *Map::RandomWalk(const Point &s, int size, int radius, const Actor
 			tries++;
 			// Give up if backed into a corner
 			if (tries > RAND_DEGREES_OF_FREEDOM) {
-				return nullptr;
+				return;
 			}
 			// Random rotation
 			i = RAND<size_t>(0, RAND_DEGREES_OF_FREEDOM - 1);
@@ -121,14 +125,14 @@ PathListNode *Map::RandomWalk(const Point &s, int size, int radius, const Actor
 		p.x -= dx;
 		p.y -= dy;
 	}
-	PathListNode *step = new PathListNode;
 	const Size& mapSize = PropsSize();
-	step->point = Clamp(p, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
-	step->orient = GetOrient(s, p);
-	return step;
+	PathNode step;
+	step.point = Clamp(p, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
+	step.orient = GetOrient(s, p);
+	path.push_back(step);
 }
 
-PathListNode *Map::GetLine(const Point &start, int Steps, orient_t Orientation, int flags) const
+Path Map::GetLine(const Point &start, int Steps, orient_t Orientation, int flags) const
 {
 	Point dest = start;
 
@@ -152,60 +156,7 @@ PathListNode *Map::GetLine(const Point &start, int Steps, orient_t Orientation,
 	dest.x += Steps * mult * xoff + 0.5;
 	dest.y += Steps * mult * yoff + 0.5;
 
-	return GetLine(start, dest, 2, Orientation, flags);
-}
-
-PathListNode *Map::GetLine(const Point &start, const Point &dest, int Speed, orient_t Orientation, int flags) const
-{
-	PathListNode *StartNode = new PathListNode;
-	PathListNode *Return = StartNode;
-	StartNode->point = start;
-	StartNode->orient = Orientation;
-
-	int Count = 0;
-	int Max = Distance(start, dest);
-	for (int Steps = 0; Steps < Max; Steps++) {
-		Point p;
-		p.x = start.x + ((dest.x - start.x) * Steps / Max);
-		p.y = start.y + ((dest.y - start.y) * Steps / Max);
-
-		//the path ends here as it would go off the screen, causing problems
-		//maybe there is a better way, but i needed a quick hack to fix
-		//the crash in projectiles
-		if (p.x < 0 || p.y < 0) {
-			return Return;
-		}
-		
-		const Size& mapSize = PropsSize();
-		if (p.x > mapSize.w * 16 || p.y > mapSize.h * 12) {
-			return Return;
-		}
-
-		if (!Count) {
-			StartNode->Next = new PathListNode;
-			StartNode->Next->Parent = StartNode;
-			StartNode = StartNode->Next;
-			Count = Speed;
-		} else {
-			Count--;
-		}
-
-		StartNode->point = p;
-		StartNode->orient = Orientation;
-		bool wall = bool(GetBlocked(p) & (PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::SIDEWALL));
-		if (wall) switch (flags) {
-			case GL_REBOUND:
-				Orientation = ReflectOrientation(Orientation);
-				// TODO: recalculate dest (mirror it)
-				break;
-			case GL_PASS:
-				break;
-			default: //premature end
-				return Return;
-		}
-	}
-
-	return Return;
+	return GetLinePath(start, dest, 2, Orientation, flags);
 }
 
 Path Map::GetLinePath(const Point &start, const Point &dest, int Speed, orient_t Orientation, int flags) const
@@ -259,22 +210,23 @@ Path Map::GetLinePath(const Point &start, const Point &dest, int Speed, orient_t
 	return path;
 }
 
-PathListNode *Map::GetLine(const Point &p, int steps, orient_t orient) const
+void Map::GetLine(Path& path, const Point &p, int steps, orient_t orient) const
 {
-	PathListNode *step = new PathListNode;
-	step->point.x = p.x + steps * SEARCHMAP_SQUARE_DIAGONAL * dxRand[orient];
-	step->point.y = p.y + steps * SEARCHMAP_SQUARE_DIAGONAL * dyRand[orient];
+	PathNode step;
+	step.point.x = p.x + steps * SEARCHMAP_SQUARE_DIAGONAL * dxRand[orient];
+	step.point.y = p.y + steps * SEARCHMAP_SQUARE_DIAGONAL * dyRand[orient];
 	const Size& mapSize = PropsSize();
-	step->point = Clamp(step->point, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
-	step->orient = GetOrient(p, step->point);
-	return step;
+	step.point = Clamp(step.point, Point(1, 1), Point((mapSize.w - 1) * 16, (mapSize.h - 1) * 12));
+	step.orient = GetOrient(p, step.point);
+	path.assign(1, step);
 }
 
 // Find a path from start to goal, ending at the specified distance from the
 // target (the goal must be in sight of the end, if PF_SIGHT is specified)
-PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, unsigned int minDistance, int flags, const Actor *caller) const
+void Map::FindPath(Path& path, const Point &s, const Point &d, unsigned int size, unsigned int minDistance, int flags, const Actor *caller) const
 {
-	TRACY(ZoneScoped);
+	PROFILE_ZONE(Pathfinding);
+	path.clear();
 	if (InDebugMode(DebugMode::PATHFINDER))
 		Log(DEBUG, "FindPath", "s = {}, d = {}, caller = {}, dist = {}, size = {}",
 			s, d,
@@ -294,18 +246,18 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 		AdjustPositionNavmap(nmptDest);
 	}
 	
-	if (nmptDest == nmptSource) return nullptr;
+	if (nmptDest == nmptSource) return;
 	
 	SearchmapPoint smptSource = Map::ConvertCoordToTile(nmptSource);
 	SearchmapPoint smptDest = Map::ConvertCoordToTile(nmptDest);
 	
 	if (minDistance < size && !(GetBlockedInRadiusTile(smptDest, size) & (PathMapFlags::PASSABLE | PathMapFlags::ACTOR))) {
 		Log(DEBUG, "FindPath", "{} can't fit in destination", fmt::WideToChar{caller ? caller->GetShortName() : u"nullptr"});
-		return nullptr;
+		return;
 	}
 
 	const Size& mapSize = PropsSize();
-	if (!mapSize.PointInside(smptSource)) return nullptr;
+	if (!mapSize.PointInside(smptSource)) return;
 
 	// Initialize data structures
 	FibonacciHeap<PQNode> open;
@@ -449,34 +401,30 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 	}
 
 	if (foundPath) {
-		PathListNode *resultPath = nullptr;
+		// collected from the goal backwards, then flipped
 		NavmapPoint nmptCurrent = nmptDest;
 		NavmapPoint nmptParent;
 		SearchmapPoint smptCurrent = Map::ConvertCoordToTile(nmptCurrent);
-		while (!resultPath || nmptCurrent != parents[smptCurrent.y * mapSize.w + smptCurrent.x]) {
+		while (path.empty() || nmptCurrent != parents[smptCurrent.y * mapSize.w + smptCurrent.x]) {
 			nmptParent = parents[smptCurrent.y * mapSize.w + smptCurrent.x];
-			PathListNode *newStep = new PathListNode;
-			newStep->point = nmptCurrent;
-			newStep->Next = resultPath;
+			PathNode newStep;
+			newStep.point = nmptCurrent;
 			// movement in general allows characters to walk backwards given that
 			// the destination is behind the character (within a threshold), and
 			// that the distance isn't too far away
 			// we approximate that with a relaxed collinearity check and intentionally
 			// skip the first step, otherwise it doesn't help with iwd beetles in ar1015
-			if (flags & PF_BACKAWAY && resultPath && std::abs(area2(nmptCurrent, resultPath->point, nmptParent)) < 300) {
-				newStep->orient = GetOrient(nmptCurrent, nmptParent);
+			if (flags & PF_BACKAWAY && !path.empty() && std::abs(area2(nmptCurrent, path.back().point, nmptParent)) < 300) {
+				newStep.orient = GetOrient(nmptCurrent, nmptParent);
 			} else {
-				newStep->orient = GetOrient(nmptParent, nmptCurrent);
+				newStep.orient = GetOrient(nmptParent, nmptCurrent);
 			}
-			if (resultPath) {
-				resultPath->Parent = newStep;
-			}
-			resultPath = newStep;
+			path.push_back(newStep);
 			nmptCurrent = nmptParent;
 
 			smptCurrent = Map::ConvertCoordToTile(nmptCurrent);
 		}
-		return resultPath;
+		std::reverse(path.begin(), path.end());
 	} else if (InDebugMode(DebugMode::PATHFINDER)) {
 		if (caller) {
 			Log(DEBUG, "FindPath", "Pathing failed for {}", fmt::WideToChar{caller->GetShortName()});
@@ -484,8 +432,6 @@ PathListNode *Map::FindPath(const Point &s, const Point &d, unsigned int size, u
 			Log(DEBUG, "FindPath", "Pathing failed");
 		}
 	}
-
-	return nullptr;
 }
 
 void Map::NormalizeDeltas(float_t &dx, float_t &dy, float_t factor)
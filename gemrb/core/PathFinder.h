@@ -60,21 +60,10 @@ struct PathNode {
 	orient_t orient;
 };
 
-// FIXME: does Path have to be a linked list?
-// its meant to replace PathListNode which is a linked list
-// however, Projectile (and presumably other future users)
-// needs to keep track of which PathNode it is currently in
-// list iterators get invalidated during copy/move
-// nor are they randomly accessible so indexing isn't a good option
+// users that need to keep track of which PathNode they are currently in
+// (Projectile, Movable) store an index, since iterators get invalidated during copy/move
 using Path = std::vector<PathNode>;
 
-struct PathListNode {
-	PathListNode* Parent = nullptr;
-	PathListNode* Next = nullptr;
-	Point point;
-	orient_t orient;
-};
-
 enum {
 	PF_SIGHT = 1,
 	PF_BACKAWAY = 2,
@@ -0,0 +1,148 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "Profiler.h"
+
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace GemRB {
+
+bool Profiler::enabled = false;
+EnumArray<ProfileZone, std::atomic<uint64_t>> Profiler::zoneNanos;
+EnumArray<ProfileCounter, std::atomic<uint32_t>> Profiler::counters;
+
+// totals since the last Report
+static EnumArray<ProfileZone, uint64_t> reportNanos;
+static EnumArray<ProfileCounter, uint64_t> reportCounts;
+static uint32_t reportFrames = 0;
+
+static std::unique_ptr<FileStream> csv;
+static uint64_t csvFrame = 0;
+
+static const char* const zoneNames[] = {
+	"Game update", "Scripts", "Actions", "Effects", "Pathfinding", "Fog",
+	"Projectiles", "Resources", "GUIScript", "Text layout", "Drawing"
+};
+static_assert(sizeof(zoneNames) / sizeof(zoneNames[0]) == size_t(ProfileZone::count), "missing zone names");
+
+static const char* const counterNames[] = {
+	"Resource loads", "Cache hits", "Draw calls", "Python calls"
+};
+static_assert(sizeof(counterNames) / sizeof(counterNames[0]) == size_t(ProfileCounter::count), "missing counter names");
+
+const char* Profiler::ZoneName(ProfileZone zone)
+{
+	return zoneNames[UnderType(zone)];
+}
+
+const char* Profiler::CounterName(ProfileCounter counter)
+{
+	return counterNames[UnderType(counter)];
+}
+
+void Profiler::Enable(bool enable)
+{
+	enabled = enable;
+	for (auto zone : EnumIterator<ProfileZone>()) {
+		zoneNanos[zone] = 0;
+		reportNanos[zone] = 0;
+	}
+	for (auto counter : EnumIterator<ProfileCounter>()) {
+		counters[counter] = 0;
+		reportCounts[counter] = 0;
+	}
+	reportFrames = 0;
+}
+
+bool Profiler::SetCSV(const path_t& path)
+{
+	csv.reset();
+	csvFrame = 0;
+	if (path.empty()) {
+		return true;
+	}
+
+	csv = std::make_unique<FileStream>();
+	if (!csv->Create(path)) {
+		Log(ERROR, "Profiler", "Cannot create {}!", path);
+		csv.reset();
+		return false;
+	}
+
+	std::string header = "frame";
+	for (auto zone : EnumIterator<ProfileZone>()) {
+		header += fmt::format(",{} ms", ZoneName(zone));
+	}
+	for (auto counter : EnumIterator<ProfileCounter>()) {
+		header += fmt::format(",{}", CounterName(counter));
+	}
+	header += '\n';
+	csv->Write(header.c_str(), header.length());
+	return true;
+}
+
+void Profiler::EndFrame()
+{
+	if (!enabled) return;
+
+	std::string line;
+	if (csv) {
+		line = fmt::format("{}", csvFrame++);
+	}
+
+	for (auto zone : EnumIterator<ProfileZone>()) {
+		uint64_t nanos = zoneNanos[zone].exchange(0, std::memory_order_relaxed);
+		reportNanos[zone] += nanos;
+		if (csv) line += fmt::format(",{:.3f}", nanos / 1000000.0);
+	}
+	for (auto counter : EnumIterator<ProfileCounter>()) {
+		uint32_t count = counters[counter].exchange(0, std::memory_order_relaxed);
+		reportCounts[counter] += count;
+		TRACY(TracyPlot(CounterName(counter), int64_t(count)));
+		if (csv) line += fmt::format(",{}", count);
+	}
+	++reportFrames;
+
+	if (csv) {
+		line += '\n';
+		csv->Write(line.c_str(), line.length());
+	}
+}
+
+std::string Profiler::Report()
+{
+	std::string report;
+	uint32_t frames = std::max(reportFrames, 1U);
+	for (auto zone : EnumIterator<ProfileZone>()) {
+		report += fmt::format("{}: {:.2f}ms\n", ZoneName(zone), reportNanos[zone] / 1000000.0 / frames);
+		reportNanos[zone] = 0;
+	}
+	for (auto counter : EnumIterator<ProfileCounter>()) {
+		report += fmt::format("{}: {}\n", CounterName(counter), reportCounts[counter] / frames);
+		reportCounts[counter] = 0;
+	}
+	reportFrames = 0;
+	report.pop_back();
+	return report;
+}
+
+}
@@ -0,0 +1,120 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+// A tiny built-in profiler, so the cost of each subsystem can be seen without Tracy.
+// PROFILE_ZONE also opens a Tracy zone, so the same sites show up in both.
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "globals.h"
+
+#include "EnumIndex.h"
+#include "System/VFS.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace GemRB {
+
+enum class ProfileZone : uint8_t {
+	GameUpdate,
+	Scripts,
+	Actions,
+	Effects,
+	Pathfinding,
+	Fog,
+	Projectiles,
+	Resources,
+	GUIScript,
+	TextLayout,
+	Drawing,
+
+	count
+};
+
+enum class ProfileCounter : uint8_t {
+	ResourceLoads,
+	CacheHits,
+	DrawCalls,
+	PythonCalls,
+
+	count
+};
+
+class GEM_EXPORT Profiler {
+	static EnumArray<ProfileZone, std::atomic<uint64_t>> zoneNanos;
+	static EnumArray<ProfileCounter, std::atomic<uint32_t>> counters;
+
+public:
+	static bool enabled;
+
+	static void AddTime(ProfileZone zone, uint64_t nanos) noexcept
+	{
+		zoneNanos[zone].fetch_add(nanos, std::memory_order_relaxed);
+	}
+
+	static void Count(ProfileCounter counter, uint32_t amount = 1) noexcept
+	{
+		if (!enabled) return;
+		counters[counter].fetch_add(amount, std::memory_order_relaxed);
+	}
+
+	static void Enable(bool enable);
+	/** Starts writing a line per frame with the time of every zone, empty path stops it */
+	static bool SetCSV(const path_t& path);
+	/** Closes the current frame, the main loop calls it once per frame */
+	static void EndFrame();
+	/** Average ms per frame of every zone and the counters since the last call, one per line */
+	static std::string Report();
+	static const char* ZoneName(ProfileZone zone);
+	static const char* CounterName(ProfileCounter counter);
+};
+
+// times are inclusive, so nested zones count in their parents as well
+class ProfileScope {
+	using clock = std::chrono::steady_clock;
+
+	ProfileZone zone;
+	clock::time_point start;
+	bool active;
+
+public:
+	explicit ProfileScope(ProfileZone zone) noexcept
+	: zone(zone), active(Profiler::enabled)
+	{
+		if (active) start = clock::now();
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+	~ProfileScope()
+	{
+		if (!active) return;
+		auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+		Profiler::AddTime(zone, uint64_t(nanos));
+	}
+};
+
+#define PROFILE_ZONE(zone) TRACY(ZoneScoped); ProfileScope profileScope(ProfileZone::zone)
+
+}
+
+#endif
@@ -1581,7 +1581,7 @@ void Projectile::SpawnChild(size_t idx, bool firstExplosion, const Point& offset
 	}
 
 	children.push_back(std::move(*pro));
-	delete pro;
+	server->Recycle(pro);
 }
 
 void Projectile::SpawnChildren()
@@ -2010,6 +2010,20 @@ void Projectile::Cleanup()
 	state = ProjectileState::EXPIRED;
 }
 
+void Projectile::Retire()
+{
+	Cleanup();
+	// same as the LoopStop destructor, which would otherwise only run on reuse
+	if (travel_handle) {
+		travel_handle->StopLooping();
+		travel_handle.sound = nullptr;
+	}
+	children.clear();
+	lineTargets.clear();
+	light = nullptr;
+	area = nullptr;
+}
+
 void Projectile::Draw(const Holder<Sprite2D>& spr, const Point& p, BlitFlags flags, Color overrideTint) const
 {
 	Holder<Palette> pal = (spr->Format().Bpp == 1) ? palette : nullptr;
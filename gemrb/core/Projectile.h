@@ -352,6 +352,8 @@ public:
 	void SetTarget(const Point &p);
 	bool PointInRadius(const Point &p) const;
 	void Cleanup();
+	//lets the sounds finish and drops the payload, before the object is pooled
+	void Retire();
 
 	Point GetPos() const { return Pos; }
 	int GetZPos() const;
@@ -33,6 +33,8 @@ namespace GemRB {
 //////////////////////////////////////////////////////////////////////
 
 #define MAX_PROJ_IDX  0x1fff
+//how many expired projectiles are kept around for reuse
+#define MAX_POOLED_PROJECTILES 64
 
 ProjectileServer::ProjectileServer() noexcept
 {
@@ -133,29 +135,59 @@ Projectile *ProjectileServer::GetProjectileByIndex(size_t idx)
 
 Projectile *ProjectileServer::ReturnCopy(size_t idx)
 {
-	Projectile *pro = new Projectile(*projectiles[idx].projectile);
+	const Projectile& proto = *projectiles[idx].projectile;
+	Projectile *pro;
+	if (pool.empty()) {
+		pro = new Projectile(proto);
+	} else {
+		// assigning keeps the capacity of the path, animation and target containers
+		pro = pool.back().release();
+		pool.pop_back();
+		*pro = proto;
+	}
 	pro->SetIdentifiers(projectiles[idx].resname, idx);
 	return pro;
 }
 
+void ProjectileServer::Recycle(Projectile* pro)
+{
+	if (!pro) return;
+
+	if (pool.size() >= MAX_POOLED_PROJECTILES) {
+		delete pro;
+		return;
+	}
+	pro->Retire();
+	pool.emplace_back(pro);
+}
+
 Projectile *ProjectileServer::GetProjectile(size_t idx)
 {
-	if (projectiles[idx].projectile) {
-		return ReturnCopy(idx);
+	if (!projectiles[idx].projectile) {
+		LoadProjectile(idx);
 	}
+	return ReturnCopy(idx);
+}
+
+void ProjectileServer::LoadProjectile(size_t idx)
+{
+	auto pro = std::make_unique<Projectile>();
+	pro->SetIdentifiers(projectiles[idx].resname, idx);
+
 	DataStream* str = gamedata->GetResourceStream(projectiles[idx].resname, IE_PRO_CLASS_ID);
 	PluginHolder<ProjectileMgr> sm = MakePluginHolder<ProjectileMgr>(IE_PRO_CLASS_ID);
 	if (!sm) {
 		delete str;
-		return CreateDefaultProjectile(idx);
+		// an empty default one
+		projectiles[idx].projectile = std::move(pro);
+		return;
 	}
 	if (!sm->Open(str)) {
-		return CreateDefaultProjectile(idx);
+		projectiles[idx].projectile = std::move(pro);
+		return;
 	}
-	Projectile *pro = new Projectile();
-	pro->SetIdentifiers(projectiles[idx].resname, idx);
 
-	sm->GetProjectile( pro );
+	sm->GetProjectile(pro.get());
 	int Type = 0xff;
 
 	if(pro->Extension) {
@@ -201,8 +233,30 @@ Projectile *ProjectileServer::GetProjectile(size_t idx)
 		pro->Extension->APFlags = explosions[Type].flags;
 	}
 
-	projectiles[idx].projectile = std::make_unique<Projectile>(*pro);
-	return pro;
+	projectiles[idx].projectile = std::move(pro);
+}
+
+void ProjectileServer::PrefetchSounds(size_t idx)
+{
+	if (!core->IsAvailable(IE_PRO_CLASS_ID) || idx >= GetHighestProjectileNumber()) {
+		return;
+	}
+	if (!projectiles[idx].projectile) {
+		// this also caches the projectile itself for when it gets fired
+		LoadProjectile(idx);
+	}
+
+	const Projectile* pro = projectiles[idx].projectile.get();
+	auto audio = core->GetAudioDrv();
+	if (!pro || !audio) {
+		return;
+	}
+	audio->Prefetch(pro->FiringSound);
+	audio->Prefetch(pro->ArrivalSound);
+	if (pro->Extension) {
+		audio->Prefetch(pro->Extension->SoundRes);
+		audio->Prefetch(pro->Extension->AreaSound);
+	}
 }
 
 size_t ProjectileServer::PrepareSymbols(const PluginHolder<SymbolMgr>& projlist) const
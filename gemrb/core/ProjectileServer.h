@@ -52,12 +52,16 @@ public:
 	size_t GetHighestProjectileNumber() const;
 	//creates an empty projectile on the fly
 	Projectile *CreateDefaultProjectile(size_t idx);
+	//loads the projectile and starts decoding its sounds ahead of use
+	void PrefetchSounds(size_t idx);
+	//takes back an expired projectile, so the next one can reuse its storage
+	void Recycle(Projectile* pro);
 private:
 	//this represents a line of projectl.ids
 	struct ProjectileEntry
 	{
 		ResRef resname;
-		std::unique_ptr<Projectile> projectile;
+		std::unique_ptr<const Projectile> projectile; // never flown, only copied from
 		
 		ProjectileEntry() noexcept = default;
 		~ProjectileEntry() noexcept = default;
@@ -79,6 +83,7 @@ private:
 
 	std::vector<ProjectileEntry> projectiles; //this is the list of projectiles
 	std::vector<ExplosionEntry> explosions;   //this is the list of explosion resources
+	std::vector<std::unique_ptr<Projectile>> pool; //retired projectiles waiting for reuse
 	// internal function: what is max valid projectile id?
 	size_t PrepareSymbols(const PluginHolder<SymbolMgr>& projlist) const;
 	// internal function: read projectiles
@@ -87,6 +92,8 @@ private:
 	Projectile *GetProjectile(size_t idx);
 	//creates a clone from the cached projectiles
 	Projectile *ReturnCopy(size_t idx);
+	//fills in the cached projectile, without handing out a copy
+	void LoadProjectile(size_t idx);
 	//returns one of the resource names
 	ResRef GetExplosion(size_t idx, int type);
 };
@@ -44,6 +44,8 @@ class GEM_EXPORT RNG {
 	std::mt19937_64 engine;
 	public:
 	static RNG& getInstance();
+	/** Restarts the sequence, so runs can be reproduced */
+	void Seed(uint64_t seed) noexcept { engine.seed(seed); }
 	
 	/**
 	 * It is possible to generate random numbers from [-min, +/-max].
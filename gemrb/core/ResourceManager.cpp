@@ -23,6 +23,7 @@
 #include "Interface.h"
 #include "Logging/Logging.h"
 #include "PluginMgr.h"
+#include "Profiler.h"
 #include "Resource.h"
 #include "ResourceDesc.h"
 
@@ -85,6 +86,7 @@ path_t TypeExt(SClass_ID type)
 
 bool ResourceManager::AddSource(const path_t& path, const std::string& description, PluginID type, int flags)
 {
+	std::lock_guard<std::recursive_mutex> lock(lookupMutex);
 	PluginHolder<ResourceSource> source = MakePluginHolder<ResourceSource>(type);
 	if (!source->Open(path, description)) {
 		Log(WARNING, "ResourceManager", "Invalid path given: {} ({})", path, description);
@@ -123,6 +125,7 @@ bool ResourceManager::Exists(StringView ResRef, SClass_ID type, bool silent) con
 {
 	if (ResRef.empty())
 		return false;
+	std::lock_guard<std::recursive_mutex> lock(lookupMutex);
 	// TODO: check various caches
 	for (const auto& path : searchPath) {
 		if (path->HasResource(ResRef, type)) {
@@ -140,6 +143,7 @@ bool ResourceManager::Exists(StringView ResRef, const TypeID *type, bool silent)
 {
 	if (ResRef[0] == '\0')
 		return false;
+	std::lock_guard<std::recursive_mutex> lock(lookupMutex);
 	// TODO: check various caches
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (const auto& type2 : types) {
@@ -161,9 +165,12 @@ DataStream* ResourceManager::GetResourceStream(StringView ResRef, SClass_ID type
 {
 	if (ResRef.empty())
 		return nullptr;
+	PROFILE_ZONE(Resources);
+	std::lock_guard<std::recursive_mutex> lock(lookupMutex);
 	for (const auto& path : searchPath) {
 		DataStream *ds = path->GetResource(ResRef, type);
 		if (ds) {
+			Profiler::Count(ProfileCounter::ResourceLoads);
 			if (!silent) {
 				Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.", ResRef, TypeExt(type), path->GetDescription());
 			}
@@ -180,6 +187,8 @@ ResourceHolder<Resource> ResourceManager::GetResource(StringView ResRef, const T
 {
 	if (ResRef.empty())
 		return nullptr;
+	PROFILE_ZONE(Resources);
+	std::lock_guard<std::recursive_mutex> lock(lookupMutex);
 	if (!silent) {
 		Log(MESSAGE, "ResourceManager", "Searching for '{}'...", ResRef);
 	}
@@ -196,6 +205,7 @@ ResourceHolder<Resource> ResourceManager::GetResource(StringView ResRef, const T
 			if (str) {
 				auto res = type2.Create(str);
 				if (res) {
+					Profiler::Count(ProfileCounter::ResourceLoads);
 					if (!silent) {
 						Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.",
 							ResRef, type2.GetExt(), path->GetDescription());
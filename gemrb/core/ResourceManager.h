@@ -29,6 +29,7 @@
 #include "System/VFS.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace GemRB {
@@ -66,6 +67,9 @@ private:
 	ResourceHolder<Resource> GetResource(StringView resname, const TypeID *type, bool silent = false, bool useCorrupt = false) const;
 
 	std::vector<PluginHolder<ResourceSource>> searchPath;
+	// the sources keep state (open archives), so lookups from the audio decoder are serialized
+	// recursive, since some importers load further resources while being opened
+	mutable std::recursive_mutex lookupMutex;
 };
 
 }
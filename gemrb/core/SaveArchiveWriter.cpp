@@ -0,0 +1,100 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "SaveArchiveWriter.h"
+
+#include "ArchiveImporter.h"
+#include "PluginMgr.h"
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace GemRB {
+
+void SaveArchiveWriter::AddFile(DataStream* uncompressed)
+{
+	members.push_back({ std::unique_ptr<DataStream>(uncompressed), false, false });
+}
+
+void SaveArchiveWriter::AddRecords(DataStream* records, bool trackOffset)
+{
+	members.push_back({ std::unique_ptr<DataStream>(records), true, trackOffset });
+}
+
+bool SaveArchiveWriter::Write(const path_t& path, unsigned int threads)
+{
+	FileStream str;
+	if (!str.Create(path)) {
+		Log(ERROR, "SaveArchiveWriter", "Cannot create archive: {}", path);
+		return false;
+	}
+
+	PluginHolder<ArchiveImporter> ai = MakePluginHolder<ArchiveImporter>(IE_SAV_CLASS_ID);
+	if (!ai) {
+		return false;
+	}
+	ai->CreateArchive(&str);
+
+	// every file is compressed into a separate record, they don't depend on each other
+	std::vector<std::unique_ptr<MemoryStream>> records(members.size());
+	std::atomic<size_t> next { 0 };
+	auto compress = [this, &records, &next]() {
+		PluginHolder<ArchiveImporter> importer = MakePluginHolder<ArchiveImporter>(IE_SAV_CLASS_ID);
+		for (size_t i = next++; i < members.size(); i = next++) {
+			const Member& member = members[i];
+			if (member.precompressed) continue;
+
+			auto record = new MemoryStream(member.data->filename.c_str(), nullptr, 0);
+			member.data->Rewind();
+			importer->AddToSaveGame(record, member.data.get(), compressionLevel);
+			records[i].reset(record);
+		}
+	};
+
+	size_t files = std::count_if(members.begin(), members.end(), [](const Member& member) {
+		return !member.precompressed;
+	});
+	threads = static_cast<unsigned int>(std::min<size_t>(std::max(threads, 1U), files));
+
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < threads; ++i) {
+		workers.emplace_back(compress);
+	}
+	compress();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	// keep the original member order, .tot and .toh have to come last
+	for (size_t i = 0; i < members.size(); ++i) {
+		DataStream* record = members[i].precompressed ? members[i].data.get() : records[i].get();
+		if (members[i].tracked) {
+			trackedOffset = str.GetPos();
+		}
+		record->Rewind();
+		ai->AddToSaveGameCompressed(&str, record);
+	}
+
+	return true;
+}
+
+}
@@ -0,0 +1,69 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SAVE_ARCHIVE_WRITER_H
+#define SAVE_ARCHIVE_WRITER_H
+
+#include "exports.h"
+
+#include "Streams/DataStream.h"
+
+#include <memory>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * Collects the cached files that go into a .sav archive, so the expensive
+ * part (compression and disk i/o) can run off the main thread.
+ * The members are read into memory by the main thread while the game state
+ * is stable, Write then only touches the data it owns.
+ */
+class GEM_EXPORT SaveArchiveWriter {
+	private:
+		struct Member {
+			std::unique_ptr<DataStream> data;
+			// already in the archive record format, copied verbatim
+			bool precompressed;
+			// remember where it ended up, see GetMemberOffset
+			bool tracked;
+		};
+
+		std::vector<Member> members;
+		size_t trackedOffset = 0;
+		int compressionLevel = 9;
+
+	public:
+		/** Takes ownership and compresses the stream into its own record */
+		void AddFile(DataStream* uncompressed);
+		/** Takes ownership of already compressed archive records */
+		void AddRecords(DataStream* records, bool trackOffset = false);
+		bool Empty() const { return members.empty(); }
+		/** 0 just stores the files, 9 (the default) is the slowest, but smallest */
+		void SetCompressionLevel(int level) { compressionLevel = level; }
+
+		/** Compresses all members (in parallel) and writes the archive in the order they were added.
+		 *  Does not use any shared game state, so it is safe to call from a worker thread. */
+		bool Write(const path_t& path, unsigned int threads);
+		/** The offset of the records added with trackOffset, valid after Write */
+		size_t GetTrackedOffset() const { return trackedOffset; }
+};
+
+}
+
+#endif
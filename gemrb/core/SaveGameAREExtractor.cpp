@@ -16,6 +16,7 @@
  *
  */
 #include "Interface.h"
+#include "SaveGameIterator.h"
 #include "Logging/Logging.h"
 #include "Streams/FileCache.h"
 #include "Streams/FileStream.h"
@@ -103,6 +104,13 @@ int32_t SaveGameAREExtractor::createCacheBlob() {
 
 int32_t SaveGameAREExtractor::extractARE(const ResRef& key) {
 	auto it = areLocations.find(key);
+	if (it == areLocations.cend()) {
+		return GEM_OK;
+	}
+
+	// the save we extract from may still be written in the background
+	core->GetSaveGameIterator()->FinishPendingSave();
+	it = areLocations.find(key);
 	if (it != areLocations.cend() && extractByEntry(key, it) != GEM_OK) {
 		return GEM_ERROR;
 	}
@@ -28,6 +28,7 @@
 #include "ImageWriter.h"
 #include "Interface.h"
 #include "PluginMgr.h"
+#include "SaveArchiveWriter.h"
 #include "SaveGameMgr.h"
 #include "Sprite2D.h"
 #include "TableMgr.h"
@@ -38,9 +39,12 @@
 #include "System/VFS.h"
 #include "fmt/chrono.h"
 
+#include <atomic>
 #include <cassert>
+#include <cstdio>
 #include <set>
 #include <ctime>
+#include <thread>
 
 #ifdef VITA
 #include <dirent.h>
@@ -273,6 +277,9 @@ static bool IsSaveGameSlot(const path_t& Path, const path_t& slotname)
 
 bool SaveGameIterator::RescanSaveGames()
 {
+	// make sure a save still being written shows up complete
+	FinishPendingSave();
+
 	// delete old entries
 	save_slots.clear();
 
@@ -396,8 +403,31 @@ void SaveGameIterator::PruneQuickSave(StringView folder) const
 	}
 }
 
-/** Save game to given directory */
-static bool DoSaveGame(const path_t& Path, bool overrideRunning)
+struct SaveGameIterator::PendingSave {
+	SaveArchiveWriter archive;
+	path_t savPath;
+	// the slot is built in tempDir and replaces slotDir only once it is complete
+	path_t tempDir;
+	path_t slotDir;
+	// the overwritten save, if it had a different name
+	path_t oldSlotDir;
+	bool overrideRunning = false;
+	bool quickSave = false;
+
+	std::thread worker;
+	std::atomic<bool> done { false };
+	bool success = false;
+};
+
+SaveGameIterator::SaveGameIterator() noexcept = default;
+
+SaveGameIterator::~SaveGameIterator() noexcept
+{
+	FinishPendingSave(false);
+}
+
+/** Save game to given directory, the archive is finished in the background */
+bool SaveGameIterator::DoSaveGame(const path_t& Path, bool overrideRunning, bool quickSave)
 {
 	const Game *game = core->GetGame();
 	//saving areas to cache currently in memory
@@ -411,9 +441,11 @@ static bool DoSaveGame(const path_t& Path, bool overrideRunning)
 
 	gamedata->SaveAllStores();
 
-	//compress files in cache named: .STO and .ARE
+	//collect files in cache named: .STO and .ARE
 	//no .CRE would be saved in cache
-	if (core->CompressSave(Path, overrideRunning)) {
+	auto save = std::make_unique<PendingSave>();
+	save->archive.SetCompressionLevel(quickSave ? core->config.QuickSaveCompression : core->config.SaveCompression);
+	if (core->CompressSave(save->archive, overrideRunning)) {
 		return false;
 	}
 
@@ -461,9 +493,106 @@ static bool DoSaveGame(const path_t& Path, bool overrideRunning)
 	outfile.Create( Path, core->GameNameResRef.c_str(), IE_BMP_CLASS_ID );
 	im->PutImage(&outfile, std::move(preview));
 
+	// everything the archive needs is in memory now, so the game can go on while it is compressed
+	save->savPath = PathJoinExt(Path, core->GameNameResRef.c_str(), TypeExt(IE_SAV_CLASS_ID));
+	save->tempDir = Path;
+	save->overrideRunning = overrideRunning;
+	save->quickSave = quickSave;
+
+	PendingSave* job = save.get();
+	unsigned int threads = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+	save->worker = std::thread([job, threads]() {
+		TRACY(tracy::SetThreadName("Save writer"));
+		tick_t startTime = GetMilliseconds();
+		job->success = job->archive.Write(job->savPath, threads);
+		Log(MESSAGE, "SaveGameIterator", "{} ms (compressing SAV file)", GetMilliseconds() - startTime);
+		job->done = true;
+	});
+	pendingSave = std::move(save);
+
+	if (!pollingPendingSave) {
+		pollingPendingSave = true;
+		core->SetTimer([this]() { PollPendingSave(); }, 100);
+	}
+
+	return true;
+}
+
+static void RemoveSaveDirectory(const path_t& path)
+{
+	DelTree(path, false);
+	RemoveDirectory(path);
+}
+
+// moves the finished slot in place, the previous save is only deleted afterwards
+static bool CommitSaveSlot(const path_t& tempDir, const path_t& slotDir, const path_t& oldSlotDir)
+{
+	path_t backupDir;
+	if (DirExists(slotDir)) {
+		backupDir = tempDir + ".old";
+		RemoveSaveDirectory(backupDir);
+		if (rename(slotDir.c_str(), backupDir.c_str())) {
+			Log(ERROR, "SaveGameIterator", "Unable to rename '{}' to '{}'", slotDir, backupDir);
+			return false;
+		}
+	}
+
+	if (rename(tempDir.c_str(), slotDir.c_str())) {
+		Log(ERROR, "SaveGameIterator", "Unable to rename '{}' to '{}'", tempDir, slotDir);
+		if (!backupDir.empty()) {
+			rename(backupDir.c_str(), slotDir.c_str());
+		}
+		return false;
+	}
+
+	if (!backupDir.empty()) {
+		RemoveSaveDirectory(backupDir);
+	}
+	if (!oldSlotDir.empty() && oldSlotDir != slotDir) {
+		RemoveSaveDirectory(oldSlotDir);
+	}
 	return true;
 }
 
+void SaveGameIterator::PollPendingSave()
+{
+	if (pendingSave && pendingSave->done) {
+		FinishPendingSave();
+	}
+}
+
+void SaveGameIterator::FinishPendingSave(bool notify)
+{
+	if (!pendingSave) {
+		return;
+	}
+
+	std::unique_ptr<PendingSave> save = std::move(pendingSave);
+	save->worker.join();
+
+	bool success = save->success && CommitSaveSlot(save->tempDir, save->slotDir, save->oldSlotDir);
+	if (!success) {
+		RemoveSaveDirectory(save->tempDir);
+	}
+	if (success && save->overrideRunning) {
+		core->saveGameAREExtractor.updateSaveGame(save->archive.GetTrackedOffset());
+	}
+
+	if (!notify) {
+		return;
+	}
+
+	if (!success) {
+		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
+	} else if (save->quickSave) {
+		// Quick-save successful
+		displaymsg->DisplayMsgCentered(HCStrings::QSaveSuccess, FT_ANY, GUIColors::XPCHANGE);
+	} else {
+		// Save successful
+		displaymsg->DisplayMsgCentered(HCStrings::SaveSuccess, FT_ANY, GUIColors::XPCHANGE);
+	}
+}
+
 static EffectRef fx_disable_rest_ref = { "DisableRest", -1 };
 static int CanSave()
 {
@@ -561,7 +690,8 @@ static int CanSave()
 	return 0;
 }
 
-static bool CreateSavePath(path_t& path, int index, StringView slotname)
+// the save is written to a hidden tempPath first, the slot directory is only replaced once it is complete
+static bool CreateSavePath(path_t& path, path_t& tempPath, int index, StringView slotname)
 {
 	path = PathJoin(core->config.SavePath, SaveDir());
 
@@ -573,18 +703,39 @@ static bool CreateSavePath(path_t& path, int index, StringView slotname)
 	//keep the first part we already determined existing
 
 	path_t dir = fmt::format("{:09d}-{}", index, slotname);
+	tempPath = PathJoin(path, "." + dir);
 	path = PathJoin(path, dir);
-	//this is required in case the old slot wasn't recognised but still there
-	DelTree(path, false);
-	if (!MakeDirectory(path)) {
-		Log(ERROR, "SaveGameIterator", "Unable to create save game directory '{}'", path);
+	//this is required in case an earlier save was interrupted
+	DelTree(tempPath, false);
+	if (!MakeDirectory(tempPath)) {
+		Log(ERROR, "SaveGameIterator", "Unable to create save game directory '{}'", tempPath);
 		return false;
 	}
 	return true;
 }
 
-int SaveGameIterator::CreateSaveGame(int index, bool mqs) const
+bool SaveGameIterator::StartSave(int index, StringView slotname, const path_t& oldSlotDir, bool overrideRunning, bool quickSave)
 {
+	path_t slotDir;
+	path_t tempDir;
+	if (!CreateSavePath(slotDir, tempDir, index, slotname)) {
+		return false;
+	}
+
+	if (!DoSaveGame(tempDir, overrideRunning, quickSave)) {
+		RemoveSaveDirectory(tempDir);
+		return false;
+	}
+
+	pendingSave->slotDir = std::move(slotDir);
+	pendingSave->oldSlotDir = oldSlotDir;
+	return true;
+}
+
+int SaveGameIterator::CreateSaveGame(int index, bool mqs)
+{
+	FinishPendingSave();
+
 	AutoTable tab = gamedata->LoadTable("savegame");
 	StringView slotname;
 	int qsave = 0;
@@ -603,6 +754,7 @@ int SaveGameIterator::CreateSaveGame(int index, bool mqs) const
 		return cansave;
 
 	bool overrideRunning = false;
+	path_t oldSlotDir;
 	//if index is not an existing savegame, we create a unique slotname
 	for (const auto& save : save_slots) {
 		if (save->GetSaveID() != index) continue;
@@ -614,40 +766,33 @@ int SaveGameIterator::CreateSaveGame(int index, bool mqs) const
 			}
 		}
 
-		DeleteSaveGame(save);
+		// only removed once the new save is complete
+		oldSlotDir = save->GetPath();
 		break;
 	}
-	path_t Path;
-	if (!CreateSavePath(Path, index, slotname)) {
-		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
-		return GEM_ERROR;
-	}
 
-	if (!DoSaveGame(Path.c_str(), overrideRunning)) {
+	if (!StartSave(index, slotname, oldSlotDir, overrideRunning, qsave)) {
 		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
 		return GEM_ERROR;
 	}
 
-	// Save successful / Quick-save successful
-	if (qsave) {
-		displaymsg->DisplayMsgCentered(HCStrings::QSaveSuccess, FT_ANY, GUIColors::XPCHANGE);
-	} else {
-		displaymsg->DisplayMsgCentered(HCStrings::SaveSuccess, FT_ANY, GUIColors::XPCHANGE);
-	}
+	// the success message is shown once the archive is written
 	return GEM_OK;
 }
 
-int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, const String& slotname, bool force) const {
+int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, const String& slotname, bool force) {
 	auto mbSlotName = MBStringFromString(slotname);
 	return CreateSaveGame(std::move(save), StringView { mbSlotName }, force);
 }
 
-int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, StringView slotname, bool force) const
+int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, StringView slotname, bool force)
 {
 	if (!slotname) {
 		return GEM_ERROR;
 	}
 
+	FinishPendingSave();
+
 	int cannotSave = CanSave();
 	if (cannotSave && !force) {
 		return cannotSave;
@@ -655,6 +800,7 @@ int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, StringView slotname,
 
 	int index;
 	bool overrideRunning = false;
+	path_t oldSlotDir;
 
 	if (save) {
 		index = save->GetSaveID();
@@ -666,7 +812,8 @@ int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, StringView slotname,
 			}
 		}
 
-		DeleteSaveGame(save);
+		// only removed once the new save is complete
+		oldSlotDir = save->GetPath();
 		save.reset();
 	} else {
 		//leave space for autosaves
@@ -695,28 +842,23 @@ int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, StringView slotname,
 		}
 	}
 
-	path_t Path;
-	if (!CreateSavePath(Path, index, slotname)) {
+	if (!StartSave(index, slotname, oldSlotDir, overrideRunning, false)) {
 		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
 		return GEM_ERROR;
 	}
 
-	if (!DoSaveGame(Path.c_str(), overrideRunning)) {
-		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
-		return GEM_ERROR;
-	}
-
-	// Save successful
-	displaymsg->DisplayMsgCentered(HCStrings::SaveSuccess, FT_ANY, GUIColors::XPCHANGE);
+	// the success message is shown once the archive is written
 	return GEM_OK;
 }
 
-void SaveGameIterator::DeleteSaveGame(const Holder<SaveGame>& game) const
+void SaveGameIterator::DeleteSaveGame(const Holder<SaveGame>& game)
 {
 	if (!game) {
 		return;
 	}
 
+	FinishPendingSave();
+
 	DelTree(game->GetPath(), false); // remove all files from folder
 	RemoveDirectory(game->GetPath());
 }
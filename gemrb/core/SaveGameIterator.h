@@ -25,6 +25,7 @@
 
 #include "SaveGame.h"
 
+#include <memory>
 #include <vector>
 
 namespace GemRB {
@@ -36,19 +37,29 @@ private:
 	using charlist = std::vector<Holder<SaveGame>>;
 	charlist save_slots;
 
+	// the .sav archive is compressed and written in the background
+	struct PendingSave;
+	std::unique_ptr<PendingSave> pendingSave;
+	bool pollingPendingSave = false;
+
 public:
-	SaveGameIterator() noexcept = default;
-	~SaveGameIterator() noexcept = default;
+	SaveGameIterator() noexcept;
+	~SaveGameIterator() noexcept;
 	const charlist& GetSaveGames();
-	void DeleteSaveGame(const Holder<SaveGame>&) const;
-	int CreateSaveGame(Holder<SaveGame> save, const String& slotname, bool force = false) const;
-	int CreateSaveGame(Holder<SaveGame>, StringView slotname, bool force = false) const;
-	int CreateSaveGame(int index, bool mqs = false) const;
+	void DeleteSaveGame(const Holder<SaveGame>&);
+	int CreateSaveGame(Holder<SaveGame> save, const String& slotname, bool force = false);
+	int CreateSaveGame(Holder<SaveGame>, StringView slotname, bool force = false);
+	int CreateSaveGame(int index, bool mqs = false);
 	Holder<SaveGame> GetSaveGame(const String& slotname);
+	/** Waits for a save still being written in the background and finalizes it */
+	void FinishPendingSave(bool notify = true);
 private:
 	bool RescanSaveGames();
 	static Holder<SaveGame> BuildSaveGame(std::string slotname);
 	void PruneQuickSave(StringView folder) const;
+	bool DoSaveGame(const path_t& path, bool overrideRunning, bool quickSave);
+	bool StartSave(int index, StringView slotname, const path_t& oldSlotDir, bool overrideRunning, bool quickSave);
+	void PollPendingSave();
 };
 
 }
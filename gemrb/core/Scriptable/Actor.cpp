@@ -39,6 +39,7 @@
 #include "ImageMgr.h"
 #include "Item.h"
 #include "PolymorphCache.h" // stupid polymorph cache hack
+#include "Profiler.h"
 #include "Projectile.h"
 #include "ProjectileServer.h"
 #include "ScriptEngine.h"
@@ -2669,6 +2670,7 @@ void Actor::AddEffects(EffectQueue&& fx)
 
 void Actor::RefreshEffects(bool first, const stats_t& previous)
 {
+	PROFILE_ZONE(Effects);
 	// some VVCs are controlled by stats (and so by PCFs), the rest have 'effect_owned' set
 	for (ScriptedAnimation* vvc : vfxQueue) {
 		if (vvc->effect_owned) vvc->active = false;
@@ -7981,7 +7983,7 @@ void Actor::NewPath()
 		return;
 	}
 	WalkTo(savedDest, InternalFlags, pathfindingDistance);
-	if (!GetPath()) {
+	if (GetPath().empty()) {
 		IncrementPathTries();
 	}
 }
@@ -10365,6 +10367,61 @@ Actor* Actor::CopySelf(bool mislead, bool effects) const
 	return newActor;
 }
 
+Actor* Actor::CopyTemplate() const
+{
+	Actor* newActor = new Actor();
+
+	newActor->InParty = InParty;
+	newActor->LongStrRef = LongStrRef;
+	newActor->ShortStrRef = ShortStrRef;
+	newActor->LongName = LongName;
+	newActor->ShortName = ShortName;
+	newActor->StrRefs = StrRefs;
+	newActor->BaseStats = BaseStats;
+	newActor->creVersion = creVersion;
+	newActor->SmallPortrait = SmallPortrait;
+	newActor->LargePortrait = LargePortrait;
+	newActor->AppearanceFlags = AppearanceFlags;
+	newActor->KillVar = KillVar;
+	newActor->IncKillVar = IncKillVar;
+	newActor->SetDeathVar = SetDeathVar;
+	newActor->IncKillCount = IncKillCount;
+	std::copy(std::begin(DeathCounters), std::end(DeathCounters), newActor->DeathCounters);
+	newActor->ignoredFields = ignoredFields;
+	newActor->scriptName = scriptName;
+	newActor->Dialog = Dialog;
+	newActor->AC.SetNatural(AC.GetNatural());
+	newActor->ToHit.SetBase(ToHit.GetBase());
+	if (PCStats) {
+		newActor->PCStats = std::make_unique<PCStatsStruct>(*PCStats);
+	}
+
+	for (int i = 0; i < MAX_SCRIPTS; i++) {
+		if (Scripts[i]) {
+			newActor->SetScript(Scripts[i]->GetName(), i, InParty != 0);
+		}
+	}
+
+	// unlike Inventory::CopyFrom, the items stay as they are
+	newActor->inventory.SetSlotCount(inventory.GetSlotCount());
+	for (int i = 0; i < inventory.GetSlotCount(); i++) {
+		const CREItem* item = inventory.GetSlotItem(i);
+		if (item) {
+			newActor->inventory.SetSlotItem(new CREItem(*item), i);
+		}
+	}
+	newActor->inventory.SetEquipped(ieWordSigned(inventory.GetEquipped()), ieWord(inventory.GetEquippedHeader()));
+
+	newActor->spellbook.CopyFrom(this);
+
+	auto fx = fxqueue.GetFirstEffect();
+	while (const Effect* effect = fxqueue.GetNextEffect(fx)) {
+		newActor->fxqueue.AddEffect(new Effect(*effect));
+	}
+
+	return newActor;
+}
+
 //high level function, used by scripting
 ieDword Actor::GetLevelInClass(ieDword classid) const
 {
@@ -1004,6 +1004,8 @@ public:
 	bool IsDualClassed() const;
 	/* Returns an exact copy of this actor */
 	Actor* CopySelf(bool mislead, bool effects = true) const;
+	/* Copies what the creature importer read into this template, see ActorMgr::CopyActor */
+	Actor* CopyTemplate() const;
 	static ieDword GetClassID(ieDword isClass);
 	const std::string& GetClassName(ieDword classID) const;
 	const std::string& GetKitName(ieDword kitID) const;
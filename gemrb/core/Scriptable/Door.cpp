@@ -50,6 +50,17 @@ void DoorTrigger::SetState(bool open)
 	}
 }
 
+Region DoorTrigger::WallsBBox() const
+{
+	Region bbox;
+	for (const auto& walls : { &openWalls, &closedWalls }) {
+		for (const auto& wp : *walls) {
+			bbox = bbox.size.IsInvalid() ? wp->BBox : Region::RegionEnclosingRegions(bbox, wp->BBox);
+		}
+	}
+	return bbox;
+}
+
 std::shared_ptr<Gem_Polygon> DoorTrigger::StatePolygon() const
 {
 	return StatePolygon(isOpen);
@@ -76,6 +87,7 @@ void Door::ImpedeBlocks(const std::vector<SearchmapPoint>& points, PathMapFlags
 void Door::UpdateDoor()
 {
 	doorTrigger.SetState(Flags&DOOR_OPEN);
+	area->InvalidateWallStencil(doorTrigger.WallsBBox());
 	outline = doorTrigger.StatePolygon();
 
 	if (outline) {
@@ -101,6 +113,7 @@ void Door::UpdateDoor()
 		ImpedeBlocks(open_ib, PathMapFlags::IMPASSABLE);
 		ImpedeBlocks(closed_ib, pmdflags);
 	}
+	area->InvalidateLOSCache();
 
 	InfoPoint *ip = area->TMap->GetInfoPoint(LinkedInfo);
 	if (ip) {
@@ -125,7 +138,7 @@ void Door::ToggleTiles(int State, int playsound)
 		}
 	}
 	for (const auto& tile : tiles) {
-		overlay->tiles[tile].tileIndex = (ieByte) state;
+		overlay->SetTileIndex(tile, (ieByte) state);
 	}
 
 	//set door_open as state
@@ -66,6 +66,8 @@ public:
 
 	std::shared_ptr<Gem_Polygon> StatePolygon() const;
 	std::shared_ptr<Gem_Polygon> StatePolygon(bool open) const;
+	// area covered by the walls of both states
+	Region WallsBBox() const;
 };
 
 class GEM_EXPORT Door : public Highlightable {
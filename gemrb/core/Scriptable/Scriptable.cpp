@@ -27,7 +27,9 @@
 #include "Game.h"
 #include "GameData.h"
 #include "Interface.h"
+#include "Profiler.h"
 #include "Projectile.h"
+#include "ProjectileServer.h"
 #include "Spell.h"
 #include "Sprite2D.h"
 #include "Video/Video.h"
@@ -204,7 +206,12 @@ void Scriptable::Update()
 void Scriptable::TickScripting()
 {
 	// Stagger script updates.
-	if (Ticks % 16 != globalID % 16) {
+	// The area relaxes idle actors even more, but anything happening to them cancels that.
+	ieDword period = 16;
+	if (triggers.empty() && !(InternalFlags & IF_FORCEUPDATE)) {
+		period *= ScriptStride;
+	}
+	if (Ticks % period != globalID % period) {
 		return;
 	}
 
@@ -255,6 +262,7 @@ void Scriptable::TickScripting()
 		TriggerCountdown--;
 	}
 
+	ScriptEvaluations++;
 	ExecuteScript(MAX_SCRIPTS);
 }
 
@@ -487,6 +495,7 @@ void Scriptable::ReleaseCurrentAction()
 
 void Scriptable::ProcessActions()
 {
+	PROFILE_ZONE(Actions);
 	if (WaitCounter) {
 		WaitCounter--;
 		if (WaitCounter) return;
@@ -541,7 +550,7 @@ bool Scriptable::InMove() const
 		return false;
 	}
 	Movable *me = (Movable *) this;
-	return me->GetStep() != NULL;
+	return me->GetStep() != nullptr;
 }
 
 void Scriptable::SetWait(tick_t time)
@@ -1332,6 +1341,10 @@ int Scriptable::SpellCast(bool instant, Scriptable* target, int level)
 	}
 
 	const SPLExtHeader *header = spl->GetExtHeader(SpellHeader);
+	// decode the sounds while the spell is being cast, so they are ready once it takes effect
+	core->GetAudioDrv()->Prefetch(spl->CompletionSound);
+	core->GetProjectileServer()->PrefetchSounds(header->ProjectileAnimation);
+
 	int casting_time = (int)header->CastingTime;
 	// how does this work for non-actors exactly?
 	if (actor) {
@@ -1965,46 +1978,36 @@ bool Highlightable::PossibleToSeeTrap() const
 
 Movable::~Movable(void)
 {
-	if (path) {
+	if (!path.empty()) {
 		ClearPath(true);
 	}
 }
 
 int Movable::GetPathLength() const
 {
-	const PathListNode *node = GetNextStep(0);
-	if (!node) return 0;
-
-	int i = 0;
-	while (node->Next) {
-		i++;
-		node = node->Next;
-	}
-	return i;
+	if (!GetNextStep(0)) return 0;
+	return int(path.size() - step - 1);
 }
 
-PathListNode *Movable::GetNextStep(int x) const
+const PathNode* Movable::GetNextStep(int x) const
 {
-	if (!step) {
+	if (step == NoStep) {
 		error("GetNextStep", "Hit with step = null");
 	}
-	PathListNode *node = step;
-	while(node && x--) {
-		node = node->Next;
-	}
-	return node;
+	size_t idx = step + x;
+	return idx < path.size() ? &path[idx] : nullptr;
 }
 
 Point Movable::GetMostLikelyPosition() const
 {
-	if (!path) {
+	if (path.empty()) {
 		return Pos;
 	}
 
 //actually, sometimes middle path would be better, if
 //we stand in Destination already
 	int halfway = GetPathLength()/2;
-	const PathListNode *node = GetNextStep(halfway);
+	const PathNode* node = GetNextStep(halfway);
 	if (node) {
 		return Map::ConvertCoordFromTile(node->point) + Point(8, 6);
 	}
@@ -2081,11 +2084,11 @@ void Movable::SetAttackMoveChances(const std::array<ieWord, 3>& amc)
 //this could be used for WingBuffet as well
 void Movable::MoveLine(int steps, orient_t orient)
 {
-	if (path || !steps) {
+	if (!path.empty() || !steps) {
 		return;
 	}
 	// DoStep takes care of stopping on walls if necessary
-	path = area->GetLine(Pos, steps, orient);
+	area->GetLine(path, Pos, steps, orient);
 }
 
 orient_t Movable::GetNextFace() const
@@ -2159,7 +2162,7 @@ void Movable::BumpBack()
 void Movable::DoStep(unsigned int walkScale, ieDword time) {
 	// Only bump back if not moving
 	// Actors can be bumped while moving if they are backing off
-	if (!path) {
+	if (path.empty()) {
 		if (IsBumped()) {
 			BumpBack();
 		}
@@ -2172,8 +2175,8 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 		timeStartStep = time;
 		return;
 	}
-	if (!step) {
-		step = path;
+	if (step == NoStep) {
+		step = 0;
 		timeStartStep = time;
 		return;
 	}
@@ -2182,7 +2185,7 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 		return;
 	}
 
-	Point nmptStep = step->point;
+	Point nmptStep = path[step].point;
 	float_t dx = nmptStep.x - Pos.x;
 	float_t dy = nmptStep.y - Pos.y;
 	Map::NormalizeDeltas(dx, dy, float_t(gamedata->GetStepTime()) / float_t(walkScale));
@@ -2210,7 +2213,7 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 	bool blocksSearch = BlocksSearchMap();
 	if (actorInTheWay && blocksSearch && actorInTheWay->BlocksSearchMap()) {
 		// Give up instead of bumping if you are close to the goal
-		if (!(step->Next) && PersonalDistance(nmptStep, this) < MAX_OPERATING_DISTANCE) {
+		if (step + 1 == path.size() && PersonalDistance(nmptStep, this) < MAX_OPERATING_DISTANCE) {
 			ClearPath(true);
 			NewOrientation = Orientation;
 			// Do not call ReleaseCurrentAction() since other actions
@@ -2221,7 +2224,7 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 		}
 		if (actor && actor->ValidTarget(GA_CAN_BUMP) && actorInTheWay->ValidTarget(GA_ONLY_BUMPABLE)) {
 			actorInTheWay->BumpAway();
-		} else if (r == 1 || actorInTheWay->GetPath()) {
+		} else if (r == 1 || !actorInTheWay->GetPath().empty()) {
 			// only back off if the immediate step is blocked or if the blocker is moving
 			// it's better to make a single step if possible, to avoid backoff loops
 			Backoff();
@@ -2249,11 +2252,11 @@ void Movable::DoStep(unsigned int walkScale, ieDword time) {
 		area->tileProps.PaintSearchMap(Map::ConvertCoordToTile(Pos), circleSize, flag);
 	}
 
-	SetOrientation(step->orient, false);
+	SetOrientation(path[step].orient, false);
 	timeStartStep = time;
 	if (Pos == nmptStep) {
-		if (step->Next) {
-			step = step->Next;
+		if (step + 1 < path.size()) {
+			step++;
 		} else {
 			ClearPath(true);
 			NewOrientation = Orientation;
@@ -2270,30 +2273,22 @@ void Movable::AdjustPosition()
 
 void Movable::AddWayPoint(const Point &Des)
 {
-	if (!path) {
+	if (path.empty()) {
 		WalkTo(Des);
 		return;
 	}
 	Destination = Des;
-	//it is tempting to use 'step' here, as it could
-	//be about half of the current path already
-	PathListNode *endNode = path;
-	while(endNode->Next) {
-		endNode = endNode->Next;
-	}
-	Point p = endNode->point;
+	Point p = path.back().point;
 	area->ClearSearchMapFor(this);
-	PathListNode* path2 = area->FindPath(p, Des, circleSize);
+	area->FindPath(newPath, p, Des, circleSize);
 	// if the waypoint is too close to the current position, no path is generated
-	if (!path2) {
+	if (newPath.empty()) {
 		if (BlocksSearchMap()) {
 			area->BlockSearchMapFor(this);
 		}
 		return;
 	}
-	endNode->Next = path2;
-	//probably it is wise to connect it both ways?
-	path2->Parent = endNode;
+	path.insert(path.end(), newPath.begin(), newPath.end());
 }
 
 // This function is called at each tick if an actor is following another actor
@@ -2301,7 +2296,7 @@ void Movable::AddWayPoint(const Point &Des)
 void Movable::WalkTo(const Point &Des, int distance)
 {
 	// Only rate-limit when moving
-	if ((GetPath() || InMove()) && prevTicks && Ticks < prevTicks + 2) {
+	if ((!path.empty() || InMove()) && prevTicks && Ticks < prevTicks + 2) {
 		return;
 	}
 
@@ -2322,16 +2317,16 @@ void Movable::WalkTo(const Point &Des, int distance)
 	}
 
 	if (BlocksSearchMap()) area->ClearSearchMapFor(this);
-	PathListNode* newPath = area->FindPath(Pos, Des, circleSize, distance, PF_SIGHT | PF_ACTORS_ARE_BLOCKING, actor);
-	if (!newPath && actor && actor->ValidTarget(GA_CAN_BUMP)) {
+	area->FindPath(newPath, Pos, Des, circleSize, distance, PF_SIGHT | PF_ACTORS_ARE_BLOCKING, actor);
+	if (newPath.empty() && actor && actor->ValidTarget(GA_CAN_BUMP)) {
 		Log(DEBUG, "WalkTo", "{} re-pathing ignoring actors", fmt::WideToChar{actor->GetShortName()});
-		newPath = area->FindPath(Pos, Des, circleSize, distance, PF_SIGHT, actor);
+		area->FindPath(newPath, Pos, Des, circleSize, distance, PF_SIGHT, actor);
 	}
 
-	if (newPath) {
+	if (!newPath.empty()) {
 		ClearPath(false);
-		path = newPath;
-		step = path;
+		path.swap(newPath);
+		step = 0;
 		HandleAnkhegStance(false);
 	}  else {
 		pathfindingDistance = std::max(circleSize, distance);
@@ -2345,13 +2340,13 @@ void Movable::RunAwayFrom(const Point &Source, int PathLength, bool noBackAway)
 {
 	ClearPath(true);
 	area->ClearSearchMapFor(this);
-	path = area->RunAway(Pos, Source, PathLength, !noBackAway, As<Actor>());
+	area->RunAway(path, Pos, Source, PathLength, !noBackAway, As<Actor>());
 	HandleAnkhegStance(false);
 }
 
 void Movable::RandomWalk(bool can_stop, bool run)
 {
-	if (path) {
+	if (!path.empty()) {
 		return;
 	}
 	// if not continuous random walk, then stops for a while
@@ -2406,12 +2401,12 @@ void Movable::RandomWalk(bool can_stop, bool run)
 
 	//the 5th parameter is controlling the orientation of the actor
 	//0 - back away, 1 - face direction
-	path = area->RandomWalk(Pos, circleSize, maxWalkDistance ? maxWalkDistance : 5, As<Actor>());
+	area->RandomWalk(path, Pos, circleSize, maxWalkDistance ? maxWalkDistance : 5, As<Actor>());
 	if (BlocksSearchMap()) {
 		area->BlockSearchMapFor(this);
 	}
-	if (path) {
-		Destination = path->point;
+	if (!path.empty()) {
+		Destination = path.front().point;
 	} else {
 		randomWalkCounter = 0;
 		WalkTo(HomeLocation);
@@ -2453,14 +2448,9 @@ void Movable::ClearPath(bool resetDestination)
 		HandleAnkhegStance(true);
 		InternalFlags &= ~IF_NORETICLE;
 	}
-	PathListNode* thisNode = path;
-	while (thisNode) {
-		PathListNode* nextNode = thisNode->Next;
-		delete thisNode;
-		thisNode = nextNode;
-	}
-	path = nullptr;
-	step = nullptr;
+	// keeps the capacity, since the path finders fill it (or newPath) in place
+	path.clear();
+	step = NoStep;
 	//don't call ReleaseCurrentAction
 }
 
@@ -2469,7 +2459,7 @@ void Movable::HandleAnkhegStance(bool emerge)
 {
 	const Actor* actor = As<Actor>();
 	int nextStance = emerge ? IE_ANI_EMERGE : IE_ANI_HIDE;
-	if (actor && path && StanceID != nextStance && actor->GetAnims()->GetAnimType() == IE_ANI_TWO_PIECE) {
+	if (actor && !path.empty() && StanceID != nextStance && actor->GetAnims()->GetAnimType() == IE_ANI_TWO_PIECE) {
 		SetStance(nextStance);
 		SetWait(15); // both stances have 15 frames, at 15 fps
 	}
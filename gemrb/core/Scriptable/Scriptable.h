@@ -28,6 +28,7 @@
 
 #include "CharAnimations.h"
 #include "OverHeadText.h"
+#include "PathFinder.h"
 
 #include <list>
 #include <map>
@@ -46,7 +47,6 @@ class InfoPoint;
 class Map;
 class Movable;
 class Object;
-struct PathListNode;
 class Projectile;
 class Scriptable;
 class Selectable;
@@ -303,6 +303,10 @@ public:
 	ieDword AuraCooldown = 0;
 	// The countdown for forced activation by triggers.
 	ieDword TriggerCountdown = 0;
+	// The number of times TickScripting() actually ran the scripts.
+	ieDword ScriptEvaluations = 0;
+	// Multiplies the script update period, set by the area for idle actors.
+	ieDword ScriptStride = 1;
 
 	// more scripting state
 	ieVarsMap locals;
@@ -489,13 +493,16 @@ public:
 
 class GEM_EXPORT Movable : public Selectable {
 private: //these seem to be sensitive, so get protection
+	static constexpr size_t NoStep = size_t(-1);
+
 	unsigned char StanceID = 0;
 	orient_t Orientation = S;
 	orient_t NewOrientation = S;
 	std::array<ieWord, 3> AttackMovements = { 100, 0, 0 };
 
-	PathListNode* path = nullptr; // whole path
-	PathListNode* step = nullptr; // actual step
+	Path path; // whole path, kept around so its storage can be reused
+	Path newPath; // where replanning happens, swapped with path on success
+	size_t step = NoStep; // index of the actual step
 	unsigned int prevTicks = 0;
 	int bumpBackTries = 0;
 	bool pathAbandoned = false;
@@ -533,18 +540,18 @@ public:
 	void BumpAway();
 	void BumpBack();
 	inline bool IsBumped() const { return bumped; }
-	PathListNode *GetNextStep(int x) const;
-	inline PathListNode *GetPath() const { return path; };
+	const PathNode* GetNextStep(int x) const;
+	inline const Path& GetPath() const { return path; };
 	inline int GetPathTries() const	{ return pathTries; }
 	inline void IncrementPathTries() { pathTries++; }
 	inline void ResetPathTries() { pathTries = 0; }
 	int GetPathLength() const;
 //inliners to protect data consistency
-	inline PathListNode * GetStep() {
-		if (!step && area) {
+	inline const PathNode* GetStep() {
+		if (step == NoStep && area) {
 			DoStep((unsigned int) ~0);
 		}
-		return step;
+		return step == NoStep ? nullptr : &path[step];
 	}
 
 	inline bool IsMoving() const {
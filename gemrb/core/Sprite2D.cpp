@@ -64,12 +64,14 @@ Sprite2D::Sprite2D(const Sprite2D &obj) noexcept
 {
 	renderFlags = obj.renderFlags;
 	freePixels = false;
+	pixelBlock = obj.pixelBlock;
 }
 
 Sprite2D::Sprite2D(Sprite2D&& obj) noexcept
 : Sprite2D(obj.Frame, obj.pixels, obj.format, obj.pitch)
 {
 	renderFlags = obj.renderFlags;
+	pixelBlock = std::move(obj.pixelBlock);
 }
 
 Sprite2D::~Sprite2D() noexcept
@@ -102,6 +104,12 @@ bool Sprite2D::IsPixelTransparent(const Point& p) const noexcept
 	return false;
 }
 
+void Sprite2D::SharePixels(std::shared_ptr<void> block) noexcept
+{
+	freePixels = false;
+	pixelBlock = std::move(block);
+}
+
 const void* Sprite2D::LockSprite() const
 {
 	return pixels;
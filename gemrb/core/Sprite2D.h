@@ -28,6 +28,7 @@
 #define SPRITE2D_H
 
 #include <cstddef>
+#include <memory>
 
 #include "RGBAColor.h"
 #include "exports.h"
@@ -56,6 +57,7 @@ enum BlitFlags : uint32_t {
 	// color/alpha mod applies to color param
 	COLOR_MOD = 0x1000, // srcC = srcC * (color / 255)
 	ALPHA_MOD = 0x2000, // srcA = srcA * (alpha / 255)
+	NO_GAMMA = 0x4000, // skip the brightness and contrast correction, for data that isn't shown as is
 	MIRRORX = 0x10000,
 	MIRRORY = 0x20000,
 	GREY = 0x80000, // timestop palette
@@ -91,6 +93,8 @@ public:
 protected:
 	void* pixels = nullptr;
 	bool freePixels = true;
+	// keeps alive the allocation our pixels are part of, when they are shared with other sprites
+	std::shared_ptr<void> pixelBlock;
 	
 	PixelFormat format;
 	uint16_t pitch = 0;
@@ -114,6 +118,10 @@ public:
 	bool IsPixelTransparent(const Point& p) const noexcept;
 	
 	uint16_t GetPitch() const noexcept { return pitch; }
+	size_t Bytes() const noexcept { return size_t(pitch) * Frame.h; }
+	/* SharePixels: the pixels belong to block (eg. all frames of an animation), so don't free them on our own.
+	   This only pools the CPU side memory, drivers still create their textures per sprite. */
+	void SharePixels(std::shared_ptr<void> block) noexcept;
 
 	virtual const void* LockSprite() const;
 	virtual void* LockSprite();
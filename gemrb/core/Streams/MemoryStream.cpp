@@ -24,10 +24,12 @@
 
 #include "Logging/Logging.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
 MemoryStream::MemoryStream(const path_t& name, void* data, strpos_t size)
-	: data((char*)data)
+	: data((char*)data), capacity(size)
 {
 	this->size = size;
 	originalfile = name;
@@ -64,12 +66,19 @@ strret_t MemoryStream::Read(void* dest, strpos_t length)
 
 strret_t MemoryStream::Write(const void* src, strpos_t length)
 {
-	if (Pos+length>size ) {
-		//error("MemoryStream", "We don't support appending to memory streams yet.");
-		return Error;
+	if (Pos + length > capacity) {
+		// appending, grow geometrically so repeated small writes stay cheap
+		strpos_t newCapacity = std::max<strpos_t>(Pos + length, capacity * 2);
+		void* grown = realloc(data, newCapacity);
+		if (!grown) {
+			return Error;
+		}
+		data = static_cast<char*>(grown);
+		capacity = newCapacity;
 	}
 	memcpy(data+Pos, src, length);
 	Pos += length;
+	size = std::max(size, Pos);
 	return length;
 }
 
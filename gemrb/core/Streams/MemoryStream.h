@@ -31,6 +31,7 @@ class GEM_EXPORT MemoryStream : public DataStream
 {
 protected:
 	char *data;
+	strpos_t capacity;
 public:
 	MemoryStream(const path_t& name, void* data, strpos_t size);
 	~MemoryStream() override;
@@ -34,6 +34,9 @@
 #include <cstdarg>
 #include <cstring>
 #include <cerrno>
+#include <ctime>
+#include <mutex>
+#include <unordered_map>
 
 #ifdef WIN32
 	// that's a workaround to live with `NOUSER` in `win32def.h`
@@ -254,20 +257,65 @@ void PathAppend(path_t& target, const path_t& name)
 	target.append(name.begin(), name.end());
 }
 
+// lowercase names of the directory entries, so resolving the case doesn't need to read the whole directory every time
+struct DirectoryIndex {
+	time_t modified = 0;
+	time_t built = 0;
+	std::unordered_map<std::string, path_t> names;
+};
+
+static std::unordered_map<std::string, DirectoryIndex> directoryIndices;
+static std::mutex directoryIndexMutex;
+
+static std::string LowerASCII(const char* name)
+{
+	std::string lower = name;
+	for (char& c : lower) {
+		c = char(std::tolower(static_cast<unsigned char>(c)));
+	}
+	return lower;
+}
+
+static bool FindIndexedMatch(const char* dir, MutableStringView item)
+{
+	struct stat buf;
+	if (stat(dir, &buf) != 0) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(directoryIndexMutex);
+	DirectoryIndex& index = directoryIndices[dir];
+	// also rebuild if it was changed in the same second it was indexed, mtime is too coarse to tell
+	if (index.built == 0 || index.modified != buf.st_mtime || buf.st_mtime >= index.built) {
+		index.names.clear();
+		index.modified = buf.st_mtime;
+		index.built = time(nullptr);
+		for (DirectoryIterator dirit(dir); dirit; ++dirit) {
+			path_t name = dirit.GetName();
+			index.names.emplace(LowerASCII(name.c_str()), std::move(name));
+		}
+	}
+
+	const auto match = index.names.find(LowerASCII(item.c_str()));
+	if (match == index.names.cend()) {
+		return false;
+	}
+	std::copy(match->second.begin(), match->second.end(), item.begin());
+	return true;
+}
+
 static bool FindMatchInDir(const char* dir, MutableStringView item)
 {
 	// this is specifically designed over a UTF-8 default, so most things except Win
 	bool multibyteCheck =
 		std::any_of(item.begin(), item.end(), [](char c) { return c < 0; });
+	if (!multibyteCheck) {
+		return FindIndexedMatch(dir, item);
+	}
 
 	for (DirectoryIterator dirit(dir); dirit; ++dirit) {
 		const path_t& name = dirit.GetName();
-		bool equal =
-			multibyteCheck
-				? UTF8_stricmp(name.c_str(), item.c_str())
-				: stricmp(name.c_str(), item.c_str()) == 0;
-
-		if (equal) {
+		if (UTF8_stricmp(name.c_str(), item.c_str())) {
 			std::copy(name.begin(), name.end(), item.begin());
 			return true;
 		}
@@ -324,6 +372,20 @@ path_t& ResolveCase(path_t& filePath)
 		return filePath;
 	}
 
+	// usually only the file name is off, so try its directory first
+	size_t lastItem = filePath.find_last_of(PathDelimiter);
+	if (lastItem != path_t::npos && lastItem > 0 && lastItem + 1 < filePath.length()) {
+		filePath[lastItem] = '\0';
+		bool dirExists = DirExists(StringView(filePath.c_str(), lastItem));
+		if (dirExists) {
+			FindMatchInDir(filePath.c_str(), MutableStringView{&filePath[lastItem + 1], filePath.length() - lastItem - 1});
+		}
+		filePath[lastItem] = PathDelimiter;
+		if (dirExists) {
+			return filePath;
+		}
+	}
+
 	size_t nextItem = filePath.find_first_of(PathDelimiter, 1);
 	if (nextItem != path_t::npos) {
 		MutableStringView msv(filePath);
@@ -385,4 +385,16 @@ Size TileMap::GetMapSize() const
 	return Size((XCellCount*64), (YCellCount*64));
 }
 
+size_t TileMap::ResidentBytes() const
+{
+	size_t bytes = 0;
+	for (const auto& overlay : overlays) {
+		if (overlay) bytes += overlay->ResidentBytes();
+	}
+	for (const auto& overlay : rain_overlays) {
+		if (overlay) bytes += overlay->ResidentBytes();
+	}
+	return bytes;
+}
+
 }
@@ -91,6 +91,8 @@ public:
 	void AddRainOverlay(TileOverlayPtr overlay);
 	void DrawOverlays(const Region& screen, bool rain, BlitFlags flags);
 	Size GetMapSize() const;
+	/** Memory held by the graphics of all the overlays */
+	size_t ResidentBytes() const;
 
 	int XCellCount = 0, YCellCount = 0;
 private:
@@ -26,16 +26,138 @@
 
 namespace GemRB {
 
+// size of the cached chunks, in area pixels
+// a multiple of the tile size, small enough to always fit within the screen clip
+static constexpr int chunkSize = 256;
+
 TileOverlay::TileOverlay(Size size) noexcept
 : size(size)
-{}
+{
+	int columns = CeilDiv(size.w * 64, chunkSize);
+	int rows = CeilDiv(size.h * 64, chunkSize);
+	chunks.resize(columns * rows);
+}
 
 void TileOverlay::AddTile(Tile&& tile)
 {
 	tiles.push_back(std::move(tile));
 }
 
-void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr> &overlays, BlitFlags flags) const
+void TileOverlay::SetTileIndex(size_t idx, unsigned char tileIndex)
+{
+	Tile& tile = tiles[idx];
+	if (tile.tileIndex == tileIndex) return;
+	tile.tileIndex = tileIndex;
+
+	int x = int(idx) % size.w * 64 / chunkSize;
+	int y = int(idx) / size.w * 64 / chunkSize;
+	chunks[y * CeilDiv(size.w * 64, chunkSize) + x].dirty = true;
+}
+
+// animated tiles are not part of the chunks, they are drawn over them every frame
+static bool IsAnimated(const Tile& tile)
+{
+	return tile.GetAnimation()->GetFrameCount() > 1;
+}
+
+const VideoBufferPtr& TileOverlay::GetChunk(int x, int y)
+{
+	Chunk& chunk = chunks[y * CeilDiv(size.w * 64, chunkSize) + x];
+	if (!chunk.dirty) {
+		return chunk.buffer;
+	}
+	chunk.dirty = false;
+
+	// clipped to the area, so the chunks on the edges don't cover anything past it
+	Region chunkRgn(x * chunkSize, y * chunkSize, chunkSize, chunkSize);
+	chunkRgn.w = std::min(chunkRgn.w, size.w * 64 - chunkRgn.x);
+	chunkRgn.h = std::min(chunkRgn.h, size.h * 64 - chunkRgn.y);
+	if (!chunk.buffer) {
+		chunk.buffer = VideoDriver->CreateBuffer(Region(Point(), chunkRgn.size));
+	}
+
+	// Draw runs while the game window's buffer is the drawing buffer, so this push and pop
+	// pair only redirects the tile blits; with nothing pushed the pop would be refused and
+	// the chunk itself would end up on the display. The screen clip belongs to the window
+	// and is swapped out for the duration, since the chunk has its own coordinates.
+	const Region clip = VideoDriver->GetScreenClip();
+	VideoDriver->SetScreenClip(nullptr);
+	VideoDriver->PushDrawingBuffer(chunk.buffer);
+	chunk.buffer->Clear();
+	for (int ty = chunkRgn.y / 64; ty < (chunkRgn.y + chunkRgn.h) / 64; ty++) {
+		for (int tx = chunkRgn.x / 64; tx < (chunkRgn.x + chunkRgn.w) / 64; tx++) {
+			const Tile& tile = tiles[ty * size.w + tx];
+			if (IsAnimated(tile)) continue;
+
+			// the tint and color correction are applied when the whole chunk is drawn
+			Point p = Point(tx * 64, ty * 64) - chunkRgn.origin;
+			VideoDriver->BlitGameSprite(tile.GetAnimation()->CurrentFrame(), p, BlitFlags::NO_GAMMA);
+		}
+	}
+	VideoDriver->PopDrawingBuffer();
+	VideoDriver->SetScreenClip(&clip);
+	return chunk.buffer;
+}
+
+void TileOverlay::DrawChunks(const Region& viewport, BlitFlags flags, const Color& tint)
+{
+	int columns = CeilDiv(size.w * 64, chunkSize);
+	int rows = CeilDiv(size.h * 64, chunkSize);
+	int xmin = std::max(viewport.x, 0) / chunkSize;
+	int ymin = std::max(viewport.y, 0) / chunkSize;
+	int xmax = std::min(columns, CeilDiv(std::max(viewport.x + viewport.w, 0), chunkSize));
+	int ymax = std::min(rows, CeilDiv(std::max(viewport.y + viewport.h, 0), chunkSize));
+
+	// the driver lost the buffer contents (eg. a mobile app was in the background)
+	if (chunkGeneration != VideoDriver->BufferGeneration()) {
+		chunkGeneration = VideoDriver->BufferGeneration();
+		for (Chunk& chunk : chunks) {
+			chunk.dirty = true;
+		}
+	}
+
+	for (int y = 0; y < rows; ++y) {
+		for (int x = 0; x < columns; ++x) {
+			// keep a ring around the view, so scrolling back and forth doesn't redraw them
+			if (x >= xmin - 1 && x <= xmax && y >= ymin - 1 && y <= ymax) continue;
+			Chunk& chunk = chunks[y * columns + x];
+			if (chunk.buffer) {
+				chunk.buffer = nullptr;
+				chunk.dirty = true;
+			}
+		}
+	}
+
+	for (int y = ymin; y < ymax; ++y) {
+		for (int x = xmin; x < xmax; ++x) {
+			// fetch the chunk before drawing, since redrawing it pushes its own buffer
+			const VideoBufferPtr& chunk = GetChunk(x, y);
+			Point p = Point(x * chunkSize, y * chunkSize) - viewport.origin;
+			VideoDriver->BlitVideoBuffer(chunk, p, flags, tint);
+		}
+	}
+}
+
+size_t TileOverlay::ResidentBytes() const
+{
+	size_t bytes = 0;
+	for (const Tile& tile : tiles) {
+		for (int i = 0; i < 2; ++i) {
+			const Animation* anim = tile.GetAnimation(i);
+			if (!anim) continue;
+			for (Animation::index_t f = 0; f < anim->GetFrameCount(); ++f) {
+				const auto frame = anim->GetFrame(f);
+				if (frame) bytes += frame->Bytes();
+			}
+		}
+	}
+	for (const Chunk& chunk : chunks) {
+		if (chunk.buffer) bytes += size_t(chunk.buffer->Size().Area()) * 4;
+	}
+	return bytes;
+}
+
+void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr> &overlays, BlitFlags flags)
 {
 	// determine which tiles are visible
 	int sx = std::max(viewport.x / 64, 0);
@@ -51,6 +173,13 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr> &over
 	}
 	const Color tintcol = globalTint ? * globalTint : Color();
 
+	// this is the base terrain, apart from the animated tiles
+	// not every backend can draw buffers grey or sepia (timestop, dreams), so then the tiles are used
+	bool useChunks = !(flags & (BlitFlags::GREY | BlitFlags::SEPIA));
+	if (useChunks) {
+		DrawChunks(viewport, flags, tintcol);
+	}
+
 	for (int y = sy; y < dy && y < size.h; y++) {
 		for (int x = sx; x < dx && x < size.w; x++) {
 			const Tile &tile = tiles[(y * size.w) + x];
@@ -59,9 +188,11 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr> &over
 			Animation* anim = tile.GetAnimation();
 			assert(anim);
 
-			// this is the base terrain tile
+			// this is the base terrain tile, if it couldn't be cached
 			Point p = Point(x * 64, y * 64) - viewport.origin;
-			VideoDriver->BlitGameSprite(anim->NextFrame(), p, flags, tintcol);
+			if (!useChunks || IsAnimated(tile)) {
+				VideoDriver->BlitGameSprite(anim->NextFrame(), p, flags, tintcol);
+			}
 
 			if (!tile.om || tile.tileIndex) {
 				continue;
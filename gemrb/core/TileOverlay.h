@@ -34,6 +34,20 @@ class GEM_EXPORT TileOverlay {
 public:
 	Size size;
 	std::vector<Tile> tiles;
+private:
+	// the still base tiles rendered into bigger buffers, so most of the layer takes a few blits
+	// chunks are created lazily, redrawn only if a door toggled tiles in them
+	// and released once they are well out of view
+	struct Chunk {
+		VideoBufferPtr buffer;
+		bool dirty = true;
+	};
+	std::vector<Chunk> chunks;
+	// the video buffer generation the chunks were drawn in
+	uint32_t chunkGeneration = 0;
+
+	const VideoBufferPtr& GetChunk(int x, int y);
+	void DrawChunks(const Region& viewport, BlitFlags flags, const Color& tint);
 public:
 	using TileOverlayPtr = Holder<TileOverlay>;
 
@@ -45,7 +59,11 @@ public:
 	TileOverlay& operator=(TileOverlay&&) noexcept = default;
 
 	void AddTile(Tile&& tile);
-	void Draw(const Region& viewport, std::vector<TileOverlayPtr> &overlays, BlitFlags flags) const;
+	/** Switches the tile between its primary and secondary (door) graphics */
+	void SetTileIndex(size_t idx, unsigned char tileIndex);
+	void Draw(const Region& viewport, std::vector<TileOverlayPtr> &overlays, BlitFlags flags);
+	/** Memory held by the tile graphics and the cached chunks */
+	size_t ResidentBytes() const;
 };
 
 }
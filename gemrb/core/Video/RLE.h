@@ -25,11 +25,10 @@
 
 namespace GemRB {
 
-inline uint8_t* DecodeRLEData(const uint8_t* p, const Size& size, colorkey_t colorKey)
+// decodes into buffer, which has to hold size.w * size.h pixels
+inline void DecodeRLEData(const uint8_t* p, const Size& size, colorkey_t colorKey, uint8_t* buffer)
 {
 	size_t pixelCount = size.w * size.h;
-	uint8_t* buffer = (uint8_t*)malloc(pixelCount);
-
 	size_t transQueue = 0;
 	for (size_t i = 0; i < pixelCount;) {
 		if (transQueue) {
@@ -46,7 +45,12 @@ inline uint8_t* DecodeRLEData(const uint8_t* p, const Size& size, colorkey_t col
 			}
 		}
 	}
-	
+}
+
+inline uint8_t* DecodeRLEData(const uint8_t* p, const Size& size, colorkey_t colorKey)
+{
+	uint8_t* buffer = (uint8_t*)malloc(size.w * size.h);
+	DecodeRLEData(p, size, colorKey, buffer);
 	return buffer;
 }
 
@@ -20,7 +20,9 @@
 
 #include "Video.h"
 
+#include "Geometry.h"
 #include "Palette.h"
+#include "Profiler.h"
 #include "Sprite2D.h"
 
 #include <cmath>
@@ -308,49 +310,141 @@ static Color ApplyFlagsForColor(const Color& inCol, BlitFlags& flags)
 void Video::DrawRect(const Region& rgn, const Color& color, bool fill, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawRectImp(rgn, c, fill, flags);
 }
 
 void Video::DrawPoint(const Point& p, const Color& color, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawPointImp(p, c, flags);
 }
 
 void Video::DrawPoints(const std::vector<Point>& points, const Color& color, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawPointsImp(points, c, flags);
 }
 
 void Video::DrawCircle(const Point& origin, uint16_t r, const Color& color, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawCircleImp(origin, r, c, flags);
 }
 
 void Video::DrawEllipse(const Region& rect, const Color& color, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawEllipseImp(rect, c, flags);
 }
 
 void Video::DrawPolygon(const Gem_Polygon* poly, const Point& origin, const Color& color, bool fill, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawPolygonImp(poly, origin, c, fill, flags);
 }
 
 void Video::DrawLine(const Point& p1, const Point& p2, const Color& color, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawLineImp(p1, p2, c, flags);
 }
 
 void Video::DrawLines(const std::vector<Point>& points, const Color& color, BlitFlags flags)
 {
 	Color c = ApplyFlagsForColor(color, flags);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	DrawLinesImp(points, c, flags);
 }
 
+void Video::DrawPrimitives(const PrimitiveBatch& batch, BlitFlags flags)
+{
+	if (batch.IsEmpty()) {
+		return;
+	}
+	Profiler::Count(ProfileCounter::DrawCalls);
+
+	if (!(flags & BlitFlags::HALFTRANS)) {
+		ApplyFlagsForColor(ColorWhite, flags);
+		DrawPrimitivesImp(batch, flags);
+		return;
+	}
+
+	// the flags change the colors, so work on a copy
+	PrimitiveBatch adjusted = batch;
+	BlitFlags colorFlags = flags;
+	for (auto& color : adjusted.pointColors) {
+		colorFlags = flags;
+		color = ApplyFlagsForColor(color, colorFlags);
+	}
+	for (auto& color : adjusted.lineColors) {
+		colorFlags = flags;
+		color = ApplyFlagsForColor(color, colorFlags);
+	}
+	ApplyFlagsForColor(ColorWhite, flags);
+	DrawPrimitivesImp(adjusted, flags);
+}
+
+void Video::DrawPrimitivesImp(const PrimitiveBatch& batch, BlitFlags flags)
+{
+	// effects use only a handful of colors, so a linear search is fine
+	std::vector<Color> colors;
+	for (const auto& color : batch.pointColors) {
+		if (std::find(colors.begin(), colors.end(), color) == colors.end()) {
+			colors.push_back(color);
+		}
+	}
+
+	std::vector<Point> points;
+	points.reserve(batch.points.size());
+	for (const auto& color : colors) {
+		points.clear();
+		for (size_t i = 0; i < batch.points.size(); ++i) {
+			if (batch.pointColors[i] == color) {
+				points.push_back(batch.points[i]);
+			}
+		}
+		DrawPointsImp(points, color, flags);
+	}
+
+	for (size_t i = 0; i < batch.lineColors.size(); ++i) {
+		DrawLineImp(batch.lines[i * 2], batch.lines[i * 2 + 1], batch.lineColors[i], flags);
+	}
+}
+
+void PrimitiveBatch::AddPoint(const Point& p, const Color& color)
+{
+	points.push_back(p);
+	pointColors.push_back(color);
+}
+
+void PrimitiveBatch::AddLine(const Point& p1, const Point& p2, const Color& color)
+{
+	lines.push_back(p1);
+	lines.push_back(p2);
+	lineColors.push_back(color);
+}
+
+void PrimitiveBatch::AddCircle(const Point& origin, uint16_t r, const Color& color)
+{
+	for (const Point& p : PlotCircle(origin, r)) {
+		AddPoint(p, color);
+	}
+}
+
+void PrimitiveBatch::Clear()
+{
+	// keep the capacity, batches are refilled every frame
+	points.clear();
+	pointColors.clear();
+	lines.clear();
+	lineColors.clear();
+}
+
 }
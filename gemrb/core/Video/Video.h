@@ -67,6 +67,24 @@ public:
 
 using VideoBufferPtr = std::shared_ptr<VideoBuffer>;
 
+/**
+ * Loose points and line segments, each with its own color.
+ * Effects collect them during a frame, so the driver can submit them with as few draw calls as possible.
+ */
+struct GEM_EXPORT PrimitiveBatch {
+	std::vector<Point> points;
+	std::vector<Color> pointColors;
+	// pairs of end points
+	std::vector<Point> lines;
+	std::vector<Color> lineColors;
+
+	void AddPoint(const Point& p, const Color& color);
+	void AddLine(const Point& p1, const Point& p2, const Color& color);
+	void AddCircle(const Point& origin, uint16_t r, const Color& color);
+	void Clear();
+	bool IsEmpty() const { return points.empty() && lines.empty(); }
+};
+
 /**
  * @class Video
  * Base class for video output plugins.
@@ -107,8 +125,12 @@ protected:
 	// the current top of drawingBuffers that draw operations occur on
 	VideoBuffer* drawingBuffer = nullptr;
 	VideoBufferPtr stencilBuffer = nullptr;
+	// bumped whenever the driver loses the contents of its buffers
+	uint32_t bufferGeneration = 0;
 
 	Region ClippedDrawingRect(const Region& target, const Region* clip = NULL) const;
+	// the fallback only saves calls by drawing all the points of a color at once
+	virtual void DrawPrimitivesImp(const PrimitiveBatch& batch, BlitFlags flags);
 	virtual void Wait(uint32_t) = 0;
 	void DestroyBuffer(VideoBuffer*);
 	void DestroyBuffers();
@@ -161,8 +183,14 @@ public:
 
 	virtual bool TouchInputEnabled() = 0;
 	virtual bool CanDrawRawGeometry() const { return false; }
+	// whether CreateSprite keeps RLE pixels as they are, instead of decoding them
+	virtual bool SupportsRLESprites() const { return true; }
+	// whether CreateSheetFrame is available, so many small sprites can be drawn from one texture
+	virtual bool SupportsSpriteSheets() const { return false; }
 
 	virtual Holder<Sprite2D> CreateSprite(const Region&, void* pixels, const PixelFormat&) = 0;
+	// a sprite for the part of sheet at pos, sharing its pixels; the sheet must come from CreateSprite
+	virtual Holder<Sprite2D> CreateSheetFrame(const Holder<Sprite2D>& /*sheet*/, const Region& /*frame*/, const Point& /*pos*/) { return nullptr; }
 	
 	void BlitSprite(const Holder<Sprite2D>& spr, Point p,
 					const Region* clip = nullptr, BlitFlags = BlitFlags::NONE);
@@ -197,6 +225,8 @@ public:
 	/** Draws a line segment */
 	void DrawLine(const Point& p1, const Point& p2, const Color& color, BlitFlags flags = BlitFlags::NONE);
 	void DrawLines(const std::vector<Point>& points, const Color& color, BlitFlags flags = BlitFlags::NONE);
+	/** Draws a whole batch of primitives, keeping their individual colors */
+	void DrawPrimitives(const PrimitiveBatch& batch, BlitFlags flags = BlitFlags::NONE);
 	virtual void DrawRawGeometry(
 		const std::vector<float>& /*vertices*/,
 		const std::vector<Color>& /*colors*/,
@@ -210,6 +240,8 @@ public:
 	/** Gets Clip Rectangle */
 	const Region& GetScreenClip() const { return screenClip; }
 	virtual void SetGamma(int brightness, int contrast) = 0;
+	/** Changes when buffer contents were lost, so whoever caches drawings in them knows to redraw */
+	uint32_t BufferGeneration() const { return bufferGeneration; }
 
 	/** Scales down a sprite by a ratio */
 	Holder<Sprite2D> SpriteScaleDown(const Holder<Sprite2D>& sprite, unsigned int ratio);
@@ -27,6 +27,8 @@
 #include "Video/Video.h"
 #include "RNG.h"
 
+#include <algorithm>
+#include <deque>
 #include <list>
 #include <utility>
 
@@ -97,12 +99,17 @@ ieDword WMPAreaEntry::GetAreaStatus() const
 //be buggy
 void WorldMap::AddAreaEntry(WMPAreaEntry&& ae)
 {
+	size_t idx = area_entries.size();
+	areaNameIndex[ae.AreaName] = idx;
+	areaResRefIndex[ae.AreaResRef] = idx;
 	area_entries.push_back(std::move(ae));
+	InvalidateTravel();
 }
 
 void WorldMap::AddAreaLink(WMPAreaLink&& al)
 {
 	area_links.push_back(std::move(al));
+	InvalidateTravel();
 }
 
 void WorldMap::SetAreaEntry(unsigned int x, WMPAreaEntry&& ae)
@@ -114,9 +121,11 @@ void WorldMap::SetAreaEntry(unsigned int x, WMPAreaEntry&& ae)
 	//altering an existing entry
 	if (x<area_entries.size()) {
 		area_entries[x] = std::move(ae);
+		RebuildAreaIndex();
+		InvalidateTravel();
 	} else {
 		//adding a new entry
-		area_entries.push_back(std::move(ae));
+		AddAreaEntry(std::move(ae));
 	}
 }
 
@@ -138,6 +147,7 @@ void WorldMap::InsertAreaLink(size_t areaIdx, WMPDirection dir, WMPAreaLink&& ar
 			}
 		}
 	}
+	InvalidateTravel();
 }
 
 void WorldMap::SetAreaLink(unsigned int x, const WMPAreaLink *arealink)
@@ -153,6 +163,23 @@ void WorldMap::SetAreaLink(unsigned int x, const WMPAreaLink *arealink)
 		//adding a new link
 		area_links.emplace_back(*arealink);
 	}
+	InvalidateTravel();
+}
+
+void WorldMap::InvalidateTravel()
+{
+	travelTables.clear();
+	linkOwners.clear();
+}
+
+void WorldMap::RebuildAreaIndex()
+{
+	areaNameIndex.clear();
+	areaResRefIndex.clear();
+	for (size_t i = 0; i < area_entries.size(); ++i) {
+		areaNameIndex[area_entries[i].AreaName] = i;
+		areaResRefIndex[area_entries[i].AreaResRef] = i;
+	}
 }
 
 void WorldMap::SetMapIcons(std::shared_ptr<AnimationFactory> newicons)
@@ -177,21 +204,25 @@ const WMPAreaEntry* WorldMap::GetArea(const ResRef& areaName) const
 	return GetArea(areaName, i);
 }
 
-WMPAreaEntry* WorldMap::GetArea(const ResRef& areaName, size_t& i)
+size_t WorldMap::FindArea(const ResRef& areaName) const
 {
-	unsigned int entryCount = (unsigned int) area_entries.size();
-	i = entryCount;
-	while (i--) {
-		if (areaName == area_entries[i].AreaName) {
-			return &area_entries[i];
-		}
+	auto it = areaNameIndex.find(areaName);
+	if (it != areaNameIndex.end()) {
+		return it->second;
 	}
 	// try also with the original name (needed for centering on Candlekeep)
-	i = entryCount;
-	while (i--) {
-		if (areaName == area_entries[i].AreaResRef) {
-			return &area_entries[i];
-		}
+	it = areaResRefIndex.find(areaName);
+	if (it != areaResRefIndex.end()) {
+		return it->second;
+	}
+	return -1;
+}
+
+WMPAreaEntry* WorldMap::GetArea(const ResRef& areaName, size_t& i)
+{
+	i = FindArea(areaName);
+	if (i != size_t(-1)) {
+		return &area_entries[i];
 	}
 	if (!core->HasFeature(GFFlags::FLEXIBLE_WMAP)) return nullptr;
 
@@ -199,7 +230,7 @@ WMPAreaEntry* WorldMap::GetArea(const ResRef& areaName, size_t& i)
 	// eg. ar4101 -> ar4100
 	// we take the first lowest area entry available that isn't too different,
 	// otherwise the wrong worldmap could get picked while testing for entry presence
-	i = entryCount;
+	i = area_entries.size();
 	int areaID = atoi(areaName.c_str() + 2);
 	while (i--) {
 		int curID = atoi(area_entries[i].AreaName.c_str() + 2);
@@ -213,19 +244,9 @@ WMPAreaEntry* WorldMap::GetArea(const ResRef& areaName, size_t& i)
 // revisit on c++17, where std::as_const can be used in many callers of the non-const version
 const WMPAreaEntry* WorldMap::GetArea(const ResRef& areaName, size_t& i) const
 {
-	unsigned int entryCount = (unsigned int) area_entries.size();
-	i = entryCount;
-	while (i--) {
-		if (areaName == area_entries[i].AreaName) {
-			return &area_entries[i];
-		}
-	}
-	// try also with the original name (needed for centering on Candlekeep)
-	i = entryCount;
-	while (i--) {
-		if (areaName == area_entries[i].AreaResRef) {
-			return &area_entries[i];
-		}
+	i = FindArea(areaName);
+	if (i != size_t(-1)) {
+		return &area_entries[i];
 	}
 	return nullptr;
 }
@@ -272,21 +293,47 @@ int WorldMap::CalculateDistances(const ResRef& areaName, WMPDirection direction)
 
 	Log(MESSAGE, "WorldMap", "CalculateDistances for Area: {}", areaName);
 
-	Distances = std::vector<int>(area_entries.size(), -1);
-	GotHereFrom = std::vector<int>(area_entries.size(), -1);
+	// the tables only stay valid while the same areas can be walked through
+	size_t entryCount = area_entries.size();
+	std::vector<bool> walkable(entryCount);
+	for (size_t idx = 0; idx < entryCount; ++idx) {
+		walkable[idx] = (area_entries[idx].GetAreaStatus() & WMP_ENTRY_WALKABLE) == WMP_ENTRY_WALKABLE;
+	}
+	if (walkable != travelWalkable) {
+		travelTables.clear();
+		travelWalkable = std::move(walkable);
+	}
+	travelTables.resize(entryCount);
+
+	TravelTable& table = travelTables[i];
+	if (table.distances.empty()) {
+		CalculateTravelTable(i, table);
+	}
+	Distances = table.distances;
+	GotHereFrom = table.gotHereFrom;
+	return 0;
+}
+
+void WorldMap::CalculateTravelTable(size_t i, TravelTable& table) const
+{
+	size_t entryCount = area_entries.size();
+	table.distances.assign(entryCount, -1);
+	table.gotHereFrom.assign(entryCount, -1);
 
-	Distances[i] = 0; //setting our own distance
-	GotHereFrom[i] = -1; //we didn't move
+	table.distances[i] = 0; //setting our own distance
+	table.gotHereFrom[i] = -1; //we didn't move
 
-	std::vector<int> seen_entry(area_entries.size());
+	// stamped with the visit number instead of being cleared for every visit
+	std::vector<size_t> seenEntry(entryCount, 0);
+	size_t visit = 0;
 
-	std::list<size_t> pending;
+	std::deque<size_t> pending;
 	pending.push_back(i);
 	while(!pending.empty()) {
 		i=pending.front();
 		pending.pop_front();
+		++visit;
 		const WMPAreaEntry& ae = area_entries[i];
-		std::fill(seen_entry.begin(), seen_entry.end(), -1);
 		//all directions should be used
 		for (WMPDirection d : EnumIterator<WMPDirection>()) {
 			int j=ae.AreaLinksIndex[d];
@@ -298,51 +345,49 @@ int WorldMap::CalculateDistances(const ResRef& areaName, WMPDirection direction)
 			}
 			for(;j<k;j++) {
 				const WMPAreaLink& al = area_links[j];
-				const WMPAreaEntry& ae2 = area_entries[al.AreaIndex];
-				unsigned int mydistance = (unsigned int) Distances[i];
+				unsigned int mydistance = (unsigned int) table.distances[i];
 
 				// we must only process the FIRST seen link to each area from this one
-				if (seen_entry[al.AreaIndex] != -1) continue;
-				seen_entry[al.AreaIndex] = 0;
-/*
-				if ( ( (ae->GetAreaStatus() & WMP_ENTRY_PASSABLE) == WMP_ENTRY_PASSABLE) &&
-				( (ae2->GetAreaStatus() & WMP_ENTRY_WALKABLE) == WMP_ENTRY_WALKABLE)
-*/
-				if ( (ae2.GetAreaStatus() & WMP_ENTRY_WALKABLE) == WMP_ENTRY_WALKABLE) {
+				if (seenEntry[al.AreaIndex] == visit) continue;
+				seenEntry[al.AreaIndex] = visit;
+
+				if (travelWalkable[al.AreaIndex]) {
 					// al->Flags is the entry direction
 					mydistance += al.DistanceScale * 4;
 					//nonexisting distance is the biggest!
-					if ((unsigned) Distances[al.AreaIndex] > mydistance) {
-						Distances[al.AreaIndex] = mydistance;
-						GotHereFrom[al.AreaIndex] = j;
+					if ((unsigned) table.distances[al.AreaIndex] > mydistance) {
+						table.distances[al.AreaIndex] = mydistance;
+						table.gotHereFrom[al.AreaIndex] = j;
 						pending.push_back(al.AreaIndex);
 					}
 				}
 			}
 		}
 	}
-
-	return 0;
 }
 
 //returns the index of the area owning this link
-size_t WorldMap::WhoseLinkAmI(int linkIndex) const
+size_t WorldMap::WhoseLinkAmI(size_t linkIndex)
 {
-	unsigned int cnt = GetEntryCount();
-	for (unsigned int i = 0; i < cnt; i++) {
-		const WMPAreaEntry& ae = area_entries[i];
-		for (WMPDirection direction : EnumIterator<WMPDirection>())
-		{
-			int j=ae.AreaLinksIndex[direction];
-			if (linkIndex < j) continue;
-
-			j += ae.AreaLinksCount[direction];
-			if (linkIndex < j) {
-				return i;
+	if (linkOwners.size() != area_links.size()) {
+		linkOwners.assign(area_links.size(), -1);
+		// iterate backwards, so the first entry covering a link wins
+		size_t i = area_entries.size();
+		while (i--) {
+			const WMPAreaEntry& ae = area_entries[i];
+			for (WMPDirection direction : EnumIterator<WMPDirection>()) {
+				size_t j = ae.AreaLinksIndex[direction];
+				size_t k = std::min<size_t>(j + ae.AreaLinksCount[direction], area_links.size());
+				for (; j < k; ++j) {
+					linkOwners[j] = i;
+				}
 			}
 		}
 	}
-	return (size_t) -1;
+	if (linkIndex >= linkOwners.size()) {
+		return -1;
+	}
+	return linkOwners[linkIndex];
 }
 
 WMPAreaLink *WorldMap::GetLink(const ResRef& A, const ResRef& B)
@@ -489,12 +534,14 @@ void WorldMap::ClearEncounterArea()
 
 	area_entries.erase(area_entries.begin() + encounterArea);
 	encounterArea = -1;
+	RebuildAreaIndex();
+	InvalidateTravel();
 }
 
 int WorldMap::GetDistance(const ResRef& areaName) const
 {
 	size_t i;
-	if (GetArea(areaName, i)) {
+	if (GetArea(areaName, i) && i < Distances.size()) {
 		return Distances[i];
 	}
 	return -1;
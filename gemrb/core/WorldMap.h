@@ -33,6 +33,7 @@
 
 #include "AnimationFactory.h"
 #include "EnumIndex.h"
+#include "Resource.h"
 #include "Sprite2D.h"
 
 #include <vector>
@@ -140,6 +141,21 @@ private: //non-struct members
 	std::vector<int> Distances;
 	std::vector<int> GotHereFrom;
 	size_t encounterArea = -1;
+
+	// name -> index of the last entry with it, so lookups match the old backwards scan
+	ResRefMap<size_t> areaNameIndex;
+	ResRefMap<size_t> areaResRefIndex;
+	// owning entry of each link, rebuilt on demand after links change
+	std::vector<size_t> linkOwners;
+
+	// travel results per source area, filled on demand and dropped when
+	// the links or the walkable areas change
+	struct TravelTable {
+		std::vector<int> distances;
+		std::vector<int> gotHereFrom;
+	};
+	std::vector<TravelTable> travelTables;
+	std::vector<bool> travelWalkable;
 public:
 	WorldMap() noexcept = default;
 
@@ -180,9 +196,13 @@ public:
 private:
 	/** updates visibility of adjacent areas, called from CalculateDistances */
 	void UpdateAreaVisibility(const ResRef& areaName, WMPDirection direction);
-	/** internal function to calculate the distances from areaindex */
-	void CalculateDistance(int areaindex, int direction);
-	size_t WhoseLinkAmI(int linkIndex) const;
+	/** fills the travel table for areaIndex with a search over the walkable areas */
+	void CalculateTravelTable(size_t areaIndex, TravelTable& table) const;
+	/** drops the travel tables and link owners after links or entries changed */
+	void InvalidateTravel();
+	void RebuildAreaIndex();
+	size_t FindArea(const ResRef& areaName) const;
+	size_t WhoseLinkAmI(size_t linkIndex);
 	/** update reachable areas from worlde.2da */
 	void UpdateReachableAreas();
 };
@@ -29,6 +29,8 @@
 #include "Video/RLE.h"
 #include "Streams/FileStream.h"
 
+#include <numeric>
+
 using namespace GemRB;
 
 bool BAMImporter::Import(DataStream* str)
@@ -121,18 +123,18 @@ bool BAMImporter::Import(DataStream* str)
 	str->Seek( PaletteOffset, GEM_STREAM_START );
 	palette = MakeHolder<Palette>();
 	Palette::Colors buffer;
+	uint8_t bgra[sizeof(buffer) / sizeof(Color) * 4] {};
+	str->Read(bgra, sizeof(bgra));
 
 	// no need to switch this
+	const uint8_t* entry = bgra;
 	for (auto& color : buffer) {
-		// bgra format
-		str->Read(&color.b, 1);
-		str->Read(&color.g, 1);
-		str->Read(&color.r, 1);
-		unsigned char a;
-		str->Read( &a, 1 );
-
+		color.b = entry[0];
+		color.g = entry[1];
+		color.r = entry[2];
 		// BAM v2 (EEs) supports alpha, but for backwards compatibility an alpha of 0 is still 255
-		color.a = a ? a : 255;
+		color.a = entry[3] ? entry[3] : 255;
+		entry += 4;
 	}
 	palette->CopyColors(0, buffer.cbegin(), buffer.cend());
 
@@ -147,7 +149,8 @@ BAMImporter::index_t BAMImporter::GetCycleSize(index_t cycle)
 	return cycles[cycle].FramesCount;
 }
 
-Holder<Sprite2D> BAMImporter::GetFrameInternal(const FrameEntry& frameInfo, bool RLESprite, uint8_t* data) const
+// pixels is where the decoded frame goes, unless it stays RLE compressed
+Holder<Sprite2D> BAMImporter::GetFrameInternal(const FrameEntry& frameInfo, bool RLESprite, uint8_t* data, uint8_t* pixels) const
 {
 	Holder<Sprite2D> spr;
 	const Region& rgn = frameInfo.bounds;
@@ -162,13 +165,7 @@ Holder<Sprite2D> BAMImporter::GetFrameInternal(const FrameEntry& frameInfo, bool
 		memcpy(pixels, dataBegin, dataLen);
 		spr = VideoDriver->CreateSprite(rgn, pixels, fmt);
 	} else {
-		void* pixels = nullptr;
-		if (frameInfo.RLE) {
-			pixels = DecodeRLEData(dataBegin, rgn.size, CompressedColorIndex);
-		} else {
-			pixels = malloc(rgn.w * rgn.h);
-			memcpy(pixels, dataBegin, rgn.w * rgn.h);
-		}
+		DecodeFrame(frameInfo, data, pixels);
 		PixelFormat fmt = PixelFormat::Paletted8Bit(palette, true, CompressedColorIndex);
 		spr = VideoDriver->CreateSprite(rgn, pixels, fmt);
 	}
@@ -176,6 +173,99 @@ Holder<Sprite2D> BAMImporter::GetFrameInternal(const FrameEntry& frameInfo, bool
 	return spr;
 }
 
+void BAMImporter::DecodeFrame(const FrameEntry& frameInfo, const uint8_t* data, uint8_t* pixels) const
+{
+	const uint8_t* dataBegin = data + frameInfo.location.dataOffset;
+	if (frameInfo.RLE) {
+		DecodeRLEData(dataBegin, frameInfo.bounds.size, CompressedColorIndex, pixels);
+	} else {
+		memcpy(pixels, dataBegin, frameInfo.bounds.size.Area());
+	}
+}
+
+// packs the frames into a few sheets (shelf packing, tallest first),
+// so the driver can draw them as parts of a handful of textures
+std::vector<Holder<Sprite2D>> BAMImporter::GetSheetFrames(uint8_t* data) const
+{
+	static constexpr int maxSheetSize = 1024;
+	static constexpr int gap = 1; // colorkeyed border, so filtering doesn't pick up the neighbours
+
+	struct Placement {
+		size_t sheet = size_t(-1);
+		Point pos;
+	};
+	std::vector<Placement> placements(frames.size());
+	std::vector<Size> sheetSizes;
+
+	std::vector<size_t> order(frames.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+		return frames[a].bounds.h > frames[b].bounds.h;
+	});
+
+	Point cursor;
+	int shelfHeight = 0;
+	for (size_t idx : order) {
+		const Size& size = frames[idx].bounds.size;
+		if (size.w + gap > maxSheetSize || size.h + gap > maxSheetSize) {
+			continue; // gets a sprite of its own
+		}
+		if (cursor.x + size.w + gap > maxSheetSize) {
+			cursor = Point(0, cursor.y + shelfHeight);
+			shelfHeight = 0;
+		}
+		if (sheetSizes.empty() || cursor.y + size.h + gap > maxSheetSize) {
+			sheetSizes.emplace_back();
+			cursor = Point();
+			shelfHeight = 0;
+		}
+
+		placements[idx].sheet = sheetSizes.size() - 1;
+		placements[idx].pos = cursor;
+		cursor.x += size.w + gap;
+		shelfHeight = std::max(shelfHeight, size.h + gap);
+		Size& sheetSize = sheetSizes.back();
+		sheetSize.w = std::max(sheetSize.w, cursor.x);
+		sheetSize.h = std::max(sheetSize.h, cursor.y + shelfHeight);
+	}
+
+	PixelFormat fmt = PixelFormat::Paletted8Bit(palette, true, CompressedColorIndex);
+	std::vector<Holder<Sprite2D>> sheets;
+	sheets.reserve(sheetSizes.size());
+	for (const Size& size : sheetSizes) {
+		void* pixels = malloc(size.Area());
+		memset(pixels, CompressedColorIndex, size.Area());
+		sheets.push_back(VideoDriver->CreateSprite(Region(Point(), size), pixels, fmt));
+	}
+
+	std::vector<Holder<Sprite2D>> sheetFrames;
+	sheetFrames.reserve(frames.size());
+	std::vector<uint8_t> scratch;
+	for (size_t idx = 0; idx < frames.size(); ++idx) {
+		const FrameEntry& frameInfo = frames[idx];
+		const Placement& placement = placements[idx];
+		if (placement.sheet >= sheets.size()) {
+			uint8_t* pixels = static_cast<uint8_t*>(malloc(frameInfo.bounds.size.Area()));
+			sheetFrames.push_back(GetFrameInternal(frameInfo, false, data, pixels));
+			continue;
+		}
+
+		const Holder<Sprite2D>& sheet = sheets[placement.sheet];
+		scratch.resize(frameInfo.bounds.size.Area());
+		DecodeFrame(frameInfo, data, scratch.data());
+
+		uint8_t* dest = static_cast<uint8_t*>(sheet->LockSprite()) + placement.pos.y * sheet->GetPitch() + placement.pos.x;
+		for (int y = 0; y < frameInfo.bounds.h; ++y) {
+			memcpy(dest + y * sheet->GetPitch(), scratch.data() + y * frameInfo.bounds.w, frameInfo.bounds.w);
+		}
+		sheet->UnlockSprite();
+
+		sheetFrames.push_back(VideoDriver->CreateSheetFrame(sheet, frameInfo.bounds, placement.pos));
+	}
+
+	return sheetFrames;
+}
+
 Holder<Sprite2D> BAMImporter::GetV2Frame(const FrameEntry& frame) {
 	size_t frameSize = frame.bounds.size.Area() * 4;
 	uint8_t *frameData = static_cast<uint8_t*>(malloc(frameSize));
@@ -250,7 +340,9 @@ std::vector<BAMImporter::index_t> BAMImporter::CacheFLT()
 
 std::shared_ptr<AnimationFactory> BAMImporter::GetAnimationFactory(const ResRef &resref, bool allowCompression)
 {
+	TRACY(ZoneScoped);
 	std::vector<Holder<Sprite2D>> animframes;
+	animframes.reserve(frames.size());
 
 	if (version == BAMVersion::V1) {
 		str->Seek( DataStart, GEM_STREAM_START );
@@ -261,9 +353,32 @@ std::shared_ptr<AnimationFactory> BAMImporter::GetAnimationFactory(const ResRef
 		uint8_t *data = (uint8_t*)malloc(length);
 		str->Read(data, length);
 
+		// no point in copying the RLE data if the driver would decode it right away
+		allowCompression = allowCompression && VideoDriver->SupportsRLESprites();
+		if (!allowCompression && VideoDriver->SupportsSpriteSheets()) {
+			animframes = GetSheetFrames(data - DataStart);
+			free(data);
+			return std::make_shared<AnimationFactory>(resref, std::move(animframes), cycles, std::move(FLT));
+		}
+
+		// the decoded frames all live in a single allocation instead of one each
+		size_t blockSize = 0;
+		for (const auto& frameInfo : frames) {
+			if (!(allowCompression && frameInfo.RLE)) {
+				blockSize += frameInfo.bounds.size.Area();
+			}
+		}
+		std::shared_ptr<uint8_t> block(static_cast<uint8_t*>(malloc(std::max<size_t>(blockSize, 1))), free);
+		uint8_t* blockPos = block.get();
+
 		for (const auto& frameInfo : frames) {
 			bool RLECompressed = allowCompression && frameInfo.RLE;
-			animframes.push_back(GetFrameInternal(frameInfo, RLECompressed, data - DataStart));
+			Holder<Sprite2D> frame = GetFrameInternal(frameInfo, RLECompressed, data - DataStart, blockPos);
+			if (!RLECompressed) {
+				if (frame) frame->SharePixels(block);
+				blockPos += frameInfo.bounds.size.Area();
+			}
+			animframes.push_back(std::move(frame));
 		}
 		free(data);
 
@@ -85,7 +85,9 @@ private:
 	void Blit(const FrameEntry& frame, const BAMV2DataBlock& dataBlock, uint8_t* data);
 	std::vector<index_t> CacheFLT();
 	Holder<Sprite2D> GetV2Frame(const FrameEntry& frame);
-	Holder<Sprite2D> GetFrameInternal(const FrameEntry& frame, bool RLESprite, uint8_t* data) const;
+	Holder<Sprite2D> GetFrameInternal(const FrameEntry& frame, bool RLESprite, uint8_t* data, uint8_t* pixels) const;
+	void DecodeFrame(const FrameEntry& frame, const uint8_t* data, uint8_t* pixels) const;
+	std::vector<Holder<Sprite2D>> GetSheetFrames(uint8_t* data) const;
 };
 
 }
@@ -46,6 +46,10 @@
 #include <cmath>
 #include <cstdio>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace GemRB;
 using namespace std::chrono;
 
@@ -201,27 +205,57 @@ bool BIKPlayer::DecodeFrame(VideoBuffer& buf)
 	if (!validVideo) {
 		return false;
 	}
+	if (!decoder.joinable()) {
+		decoder = std::thread(&BIKPlayer::DecodeLoop, this);
+	}
 
 	if (lastTime > seconds(0)) {
 		// quick hack, we should rather use the rational time base as ffmpeg
 		timer_wait(microseconds(v_timebase.num * 1000000 / v_timebase.den));
 	}
-	if(framePos >= header.framecount) {
-		return false;
-	}
-	binkframe frame = frames[framePos++];
-	str->Seek(frame.pos, GEM_STREAM_START);
-	ieDword audframesize;
-	str->ReadDword(audframesize);
-	frame.size = str->Read( inbuff, frame.size - 4 );
-	if (s_stream > -1 && DecodeAudioFrame(inbuff, audframesize)) {
-		//buggy frame, we stop immediately
-		//return false;
+
+	const DecodedFrame* frame;
+	{
+		std::unique_lock<std::mutex> lock(queueLock);
+		queueCond.wait(lock, [this]() { return queueCount > 0 || decodingDone; });
+		if (!queueCount) {
+			return false;
+		}
+		frame = &decoded[queueHead];
 	}
-	if (DecodeVideoFrame(inbuff + audframesize, static_cast<int>(frame.size - audframesize), buf)) {
+	if (frame->status) {
 		//buggy frame, we stop immediately
 		return false;
 	}
+	framePos++;
+
+	// the audio driver is only ever fed from the main thread
+	if (!frame->samples.empty()) {
+		queueBuffer(s_stream, 16, s_channels, const_cast<ieWordSigned*>(frame->samples.data()),
+			int(frame->samples.size() * sizeof(ieWordSigned)), header.samplerate);
+	}
+
+	if (video_frameskip) {
+		video_frameskip--;
+		video_skippedframes++;
+	} else {
+		const Size& bufsize = buf.Size();
+		int dest_x = unsigned(bufsize.w - header.width) >> 1;
+		int dest_y = unsigned(bufsize.h - header.height) >> 1;
+
+		buf.CopyPixels(Region(dest_x, dest_y, header.width, header.height),
+					   frame->pic.data[0], &frame->pic.linesize[0], // Y
+					   frame->pic.data[1], &frame->pic.linesize[1], // U
+					   frame->pic.data[2], &frame->pic.linesize[2]);// V
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(queueLock);
+		queueHead = (queueHead + 1) % BIK_FRAME_QUEUE;
+		queueCount--;
+	}
+	queueCond.notify_all();
+
 	if (lastTime == seconds(0)) {
 		timer_start();
 	}
@@ -229,8 +263,81 @@ bool BIKPlayer::DecodeFrame(VideoBuffer& buf)
 	return true;
 }
 
+// runs on the decoder thread; it owns the stream and the codec state until it exits
+void BIKPlayer::DecodeLoop()
+{
+	TRACY(tracy::SetThreadName("Movie decoder"));
+	size_t slot = 0;
+	ieDword decodedFrames = 0;
+	microseconds busy(0);
+
+	for (ieDword pos = 0; pos < header.framecount; pos++) {
+		{
+			std::unique_lock<std::mutex> lock(queueLock);
+			queueCond.wait(lock, [this]() { return stopDecoding || queueCount < BIK_FRAME_QUEUE; });
+			if (stopDecoding) {
+				break;
+			}
+		}
+
+		// the previous frame stays untouched in its slot, so it can be the motion reference
+		microseconds start = get_current_time();
+		DecodedFrame& frame = decoded[slot];
+		c_pic = &frame.pic;
+		frame.status = DecodeBinkFrame(frames[pos], frame.samples);
+		c_last = c_pic;
+		busy += get_current_time() - start;
+		decodedFrames++;
+
+		{
+			std::lock_guard<std::mutex> lock(queueLock);
+			queueCount++;
+		}
+		queueCond.notify_all();
+		if (frame.status) {
+			break;
+		}
+		slot = (slot + 1) % BIK_FRAME_QUEUE;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(queueLock);
+		decodingDone = true;
+	}
+	queueCond.notify_all();
+
+	if (busy.count() > 0) {
+		Log(DEBUG, "BIKPlayer", "Decoded {} frames in {}ms ({} fps)", decodedFrames,
+			busy.count() / 1000, decodedFrames * 1000000 / busy.count());
+	}
+}
+
+int BIKPlayer::DecodeBinkFrame(const binkframe& frame, std::vector<ieWordSigned>& samples)
+{
+	str->Seek(frame.pos, GEM_STREAM_START);
+	ieDword audframesize;
+	str->ReadDword(audframesize);
+	strret_t size = str->Read(inbuff, frame.size - 4);
+	samples.clear();
+	if (s_stream > -1 && DecodeAudioFrame(inbuff, audframesize, samples)) {
+		//buggy frame, we stop immediately
+		//return -1;
+	}
+	return DecodeVideoFrame(inbuff + audframesize, static_cast<int>(size - audframesize));
+}
+
 void BIKPlayer::Stop()
 {
+	{
+		std::lock_guard<std::mutex> lock(queueLock);
+		stopDecoding = true;
+	}
+	queueCond.notify_all();
+	if (decoder.joinable()) {
+		decoder.join();
+	}
+	validVideo = false;
+
 	if (s_stream > -1)
 		EndAudio();
 	EndVideo();
@@ -388,11 +495,11 @@ int BIKPlayer::video_init()
 		}
 	}
 	
-	c_pic = &c_frames[0];
-	c_last = &c_frames[1];
-	
-	c_pic->get_buffer(header.width, header.height);
-	c_last->get_buffer(header.width, header.height);
+	for (auto& frame : decoded) {
+		frame.pic.get_buffer(header.width, header.height);
+	}
+	c_pic = &decoded[0].pic;
+	c_last = &decoded[BIK_FRAME_QUEUE - 1].pic;
 	
 
 	ff_init_scantable(&c_scantable, bink_scan);
@@ -577,7 +684,7 @@ void BIKPlayer::DecodeBlock(short *out)
 }
 
 //audio samples
-int BIKPlayer::DecodeAudioFrame(void *data, int data_size)
+int BIKPlayer::DecodeAudioFrame(void *data, int data_size, std::vector<ieWordSigned>& samples)
 {
 	if (data_size == 0) return 0;
 	
@@ -585,13 +692,10 @@ int BIKPlayer::DecodeAudioFrame(void *data, int data_size)
 	s_gb.init_get_bits((uint8_t *) data, bits);
 
 	unsigned int reported_size = s_gb.get_bits_long(32);
-	ieWordSigned *samples = (ieWordSigned *) calloc(reported_size+s_block_size,1);
-	if (!samples) {
-		return -1;
-	}
+	samples.assign((reported_size + s_block_size + 1) / sizeof(ieWordSigned), 0);
 
-	ieWordSigned *outbuf = samples;
-	const ieWordSigned *samples_end  = samples + reported_size / sizeof(ieWordSigned);
+	ieWordSigned *outbuf = samples.data();
+	const ieWordSigned *samples_end  = samples.data() + reported_size / sizeof(ieWordSigned);
 
 	//s_block_size is in sample units
 	while (s_gb.get_bits_count() < bits && outbuf + s_block_size <= samples_end) {
@@ -600,15 +704,13 @@ int BIKPlayer::DecodeAudioFrame(void *data, int data_size)
 		s_gb.get_bits_align32();
 	}
 
-	unsigned int ret = (unsigned int) ((uint8_t*)outbuf - (uint8_t*)samples);
+	unsigned int ret = (unsigned int) ((uint8_t*)outbuf - (uint8_t*)samples.data());
 
 	//sample format is signed 16 bit integers
 	//ret is a better value here as it provides almost perfect sound.
 	//Original ffmpeg code produces worse results with reported_size.
 	//Ideally ret == reported_size
-	queueBuffer(s_stream, 16, s_channels, samples, ret, header.samplerate);
-
-	free(samples);
+	samples.resize(ret / sizeof(ieWordSigned));
 	return reported_size!=ret;
 }
 
@@ -1069,6 +1171,45 @@ inline int BIKPlayer::get_value(int bundle)
 	dst[(x)*2 +     ((y)*2 + 1) * stride] = \
 	dst[(x)*2 + 1 + ((y)*2 + 1) * stride] = pix
 
+#ifdef __SSE2__
+// one 8 pixel row per iteration; the masking keeps the wrapping behaviour of the plain loops
+static void get_pixels(DCTELEM *block, const uint8_t *pixels, int line_size)
+{
+	const __m128i zero = _mm_setzero_si128();
+	for (int i = 0; i < 8; i++) {
+		__m128i row = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixels));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(block), _mm_unpacklo_epi8(row, zero));
+		pixels += line_size;
+		block += 8;
+	}
+}
+
+static void put_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
+{
+	const __m128i lowByte = _mm_set1_epi16(0xff);
+	for (int i = 0; i < 8; i++) {
+		__m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+		row = _mm_and_si128(row, lowByte);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(pixels), _mm_packus_epi16(row, row));
+		pixels += line_size;
+		block += 8;
+	}
+}
+
+static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i lowByte = _mm_set1_epi16(0xff);
+	for (int i = 0; i < 8; i++) {
+		__m128i row = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixels));
+		row = _mm_add_epi16(_mm_unpacklo_epi8(row, zero), _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)));
+		row = _mm_and_si128(row, lowByte);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(pixels), _mm_packus_epi16(row, row));
+		pixels += line_size;
+		block += 8;
+	}
+}
+#else
 static void get_pixels(DCTELEM *block, const uint8_t *pixels, int line_size)
 {
 	/* read the pixels */
@@ -1119,6 +1260,7 @@ static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int lin
 		block += 8;
 	}
 }
+#endif
 
 static inline void copy_block(DCTELEM block[64], const uint8_t *src, uint8_t *dst, int stride)
 {
@@ -1217,7 +1359,7 @@ static void idct_add(uint8_t *dest, int line_size, DCTELEM *block)
 	add_pixels_nonclamped(block, dest, line_size);
 }
 
-int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
+int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 {
 	int i;
 	uint8_t* dst;
@@ -1437,21 +1579,6 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
 		v_gb.get_bits_align32();
 	}
 
-	if (video_frameskip) {
-		video_frameskip--;
-		video_skippedframes++;
-	} else {
-		const Size& bufsize = buf.Size();
-		int dest_x = unsigned(bufsize.w - header.width) >> 1;
-		int dest_y = unsigned(bufsize.h - header.height) >> 1;
-
-		buf.CopyPixels(Region(dest_x, dest_y, header.width, header.height),
-					   c_pic->data[0], &c_pic->linesize[0], // Y
-					   c_pic->data[1], &c_pic->linesize[1], // U
-					   c_pic->data[2], &c_pic->linesize[2]);// V
-	}
-
-	std::swap(c_pic, c_last);
 	return 0;
 }
 
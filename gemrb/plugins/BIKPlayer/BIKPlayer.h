@@ -32,6 +32,9 @@
 #include "dsputil.h"
 #include "rational.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace GemRB {
@@ -41,6 +44,8 @@ namespace GemRB {
 
 #define MAX_CHANNELS 2
 #define BINK_BLOCK_MAX_SIZE (MAX_CHANNELS << 11)
+// how many frames the decoder thread may run ahead of presentation
+#define BIK_FRAME_QUEUE 4
 
 #if defined(__arm__)
 #define SET_INT_TYPE uint8_t
@@ -152,6 +157,13 @@ typedef struct AVFrame {
 	}
 } AVFrame;
 
+// a fully decoded frame, waiting to be presented
+struct DecodedFrame {
+	AVFrame pic;
+	std::vector<ieWordSigned> samples;
+	int status = 0; // nonzero if the frame was broken
+};
+
 typedef struct {
 	char signature[BIK_SIGNATURE_LEN];
 	ieDword filesize;
@@ -234,10 +246,19 @@ private:
 	int16_t table[16 * 128][2]{};
 	GetBitContext v_gb;
 	
-	AVFrame c_frames[2];
 	AVFrame* c_pic = nullptr;
 	AVFrame* c_last = nullptr;
 
+	// the decoder thread fills this ring, DecodeFrame only presents from it
+	DecodedFrame decoded[BIK_FRAME_QUEUE];
+	size_t queueHead = 0;
+	size_t queueCount = 0;
+	bool decodingDone = false;
+	bool stopDecoding = false;
+	std::mutex queueLock;
+	std::condition_variable queueCond;
+	std::thread decoder;
+
 private:
 	void segment_video_play();
 	strret_t fileRead(strpos_t pos, void* buf, strpos_t count);
@@ -252,7 +273,7 @@ private:
 	void av_set_pts_info(AVRational &time_base, unsigned int pts_num, unsigned int pts_den) const;
 	int ReadHeader();
 	void DecodeBlock(short *out);
-	int DecodeAudioFrame(void *data, int data_size);
+	int DecodeAudioFrame(void *data, int data_size, std::vector<ieWordSigned>& samples);
 	inline int get_value(int bundle);
 	int read_dct_coeffs(DCTELEM block[64], const uint8_t *scan, bool is_intra);
 	int read_residue(DCTELEM block[64], int masks_count);
@@ -265,7 +286,9 @@ private:
 	int get_vlc2(int16_t (*table)[2], int bits, int max_depth);
 	void read_bundle(int bundle_num);
 	void init_lengths(int width, int bw);
-	int DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf);
+	int DecodeVideoFrame(void *data, int data_size);
+	int DecodeBinkFrame(const binkframe& frame, std::vector<ieWordSigned>& samples);
+	void DecodeLoop();
 	int EndAudio();
 	int EndVideo();
 
@@ -819,6 +819,50 @@ void CREImporter::ReadDialog(Actor *act)
 }
 
 Actor* CREImporter::GetActor(unsigned char is_in_party)
+{
+	Actor* act = ParseActor(is_in_party);
+	if (act) {
+		SetupActor(act);
+	}
+	return act;
+}
+
+Actor* CREImporter::GetActorTemplate()
+{
+	return ParseActor(0);
+}
+
+Actor* CREImporter::CopyActor(const Actor& actorTemplate)
+{
+	Actor* act = actorTemplate.CopyTemplate();
+	SetupActor(act);
+	return act;
+}
+
+// the random and game state dependent parts, done for each instance
+void CREImporter::SetupActor(Actor* act) const
+{
+	// pst reads its own colors over these
+	if (CREVersion != CREVersion::V1_2) {
+		for (int i = 0; i < 7; i++) {
+			ieDword t = Colors[i];
+			// apply RANDCOLR.2DA transformation
+			SetupColor(t);
+			t |= t << 8;
+			t |= t << 16;
+			act->BaseStats[IE_COLORS + i] = t;
+		}
+	}
+
+	// some equipping effects require everything to be set up, which may not be the case on first load
+	if (EquipBest && core->GetGame()) {
+		act->inventory.EquipBestWeapon(EQUIP_MELEE);
+	}
+
+	act->InitStatsOnLoad();
+}
+
+Actor* CREImporter::ParseActor(unsigned char is_in_party)
 {
 	Actor* act = new Actor();
 	act->InParty = is_in_party;
@@ -847,16 +891,7 @@ Actor* CREImporter::GetActor(unsigned char is_in_party)
 	}
 	str->ReadScalar<Actor::stat_t, ieWord>(act->BaseStats[IE_MAXHITPOINTS]);
 	str->ReadDword(act->BaseStats[IE_ANIMATION_ID]);//animID is a dword
-	ieByte tmp2[7];
-	str->Read( tmp2, 7);
-	for (int i=0;i<7;i++) {
-		ieDword t = tmp2[i];
-		// apply RANDCOLR.2DA transformation
-		SetupColor(t);
-		t |= t << 8;
-		t |= t << 16;
-		act->BaseStats[IE_COLORS+i]=t;
-	}
+	str->Read(Colors, 7);
 
 	str->Read( &TotSCEFF, 1 );
 	if (CREVersion== CREVersion::V1_0 && TotSCEFF) {
@@ -918,8 +953,6 @@ Actor* CREImporter::GetActor(unsigned char is_in_party)
 		ReadChrHeader(act);
 	}
 
-	act->InitStatsOnLoad();
-
 	return act;
 }
 
@@ -1120,10 +1153,9 @@ void CREImporter::ReadInventory(Actor* act, size_t slotCount)
 
 	// now that we have all items, check if we need to jump through hoops to get a proper equipped slot
 	// move to fx_summon_creature2 if it turns out something else relies on having nothing equipped
-	if (eqslot == -1) {
+	EquipBest = eqslot == -1;
+	if (EquipBest) {
 		act->inventory.SetEquipped(0, eqheader); // just reset Equipped, so EquipBestWeapon does its job
-		// some equipping effects require everything to be set up, which may not be the case on first load
-		if (core->GetGame()) act->inventory.EquipBestWeapon(EQUIP_MELEE);
 	}
 
 	indices.clear();
@@ -55,11 +55,16 @@ private:
 	int QWPCount = 0; // weapons
 	int QSPCount = 0; // spells
 	int QITCount = 0; // items
+	// what SetupActor rolls and picks for each instance
+	ieByte Colors[7] {};
+	bool EquipBest = false;
 public:
 	CREImporter(void);
 
 	bool Import(DataStream* stream) override;
 	Actor* GetActor(unsigned char is_in_party) override;
+	Actor* GetActorTemplate() override;
+	Actor* CopyActor(const Actor& actorTemplate) override;
 
 	ieWord FindSpellType(const ResRef& name, unsigned short &level, unsigned int clsMask, unsigned int kit) const override;
 
@@ -94,6 +99,8 @@ private:
 	CREMemorizedSpell* GetMemorizedSpell();
 	CREItem* GetItem();
 	void SetupColor(ieDword&) const;
+	Actor* ParseActor(unsigned char is_in_party);
+	void SetupActor(Actor* act) const;
 
 	int PutActorGemRB(DataStream *stream, const Actor *actor, ieDword InvSize) const;
 	int PutActorPST(DataStream *stream, const Actor *actor) const;
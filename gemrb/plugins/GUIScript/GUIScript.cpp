@@ -69,6 +69,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <vector>
 
 using namespace GemRB;
 
@@ -4436,7 +4437,7 @@ static PyObject* GemRB_SaveGame(PyObject * /*self*/, PyObject * args)
 
 	GET_GAME();
 
-	const SaveGameIterator *sgip = core->GetSaveGameIterator();
+	SaveGameIterator *sgip = core->GetSaveGameIterator();
 	if (!sgip) {
 		return RuntimeError("No savegame iterator");
 	}
@@ -13310,6 +13311,7 @@ GUIScript::GUIScript(void)
 GUIScript::~GUIScript(void)
 {
 	if (Py_IsInitialized()) {
+		ClearFunctionCache();
 		if (pModule) {
 			Py_DECREF( pModule );
 		}
@@ -13502,6 +13504,8 @@ bool GUIScript::LoadScript(const std::string& filename)
 	if (pModule) {
 		Py_DECREF( pModule );
 	}
+	// unqualified functions resolve to the new module
+	ClearFunctionCache();
 
 	pModule = PyImport_Import( pName );
 	Py_DECREF( pName );
@@ -13583,11 +13587,95 @@ GUIScript::Parameter GUIScript::RunFunction(const char* Modulename, const char*
 	return ret;
 }
 
+void GUIScript::ClearFunctionCache()
+{
+	for (const auto& entry : functionCache) {
+		Py_XDECREF(entry.second.module);
+		Py_XDECREF(entry.second.name);
+	}
+	functionCache.clear();
+}
+
+/* Returns a new reference to the named function, nullptr if it doesn't exist */
+PyObject* GUIScript::ResolveFunction(const char* moduleName, const char* functionName, bool report_error)
+{
+	std::string key = moduleName ? moduleName : "";
+	key += '.';
+	key += functionName;
+
+	auto cached = functionCache.find(key);
+	if (cached == functionCache.end()) {
+		PyObject* pyModule;
+		if (moduleName) {
+			pyModule = PyImport_ImportModule(moduleName);
+		} else {
+			pyModule = pModule;
+			Py_XINCREF(pyModule);
+		}
+		if (!pyModule) {
+			PyErr_Print();
+			return nullptr;
+		}
+		PyObject* name = PyUnicode_InternFromString(functionName);
+		cached = functionCache.emplace(key, CachedFunction { pyModule, name }).first;
+	}
+
+	// the lookup itself is cheap with the interned name and it
+	// also keeps working when scripts rebind or reload module functions
+	PyObject* dict = PyModule_GetDict(cached->second.module);
+	PyObject* pFunc = PyDict_GetItem(dict, cached->second.name);
+	if (!PyCallable_Check(pFunc)) {
+		if (report_error) {
+			Log(ERROR, "GUIScript", "Missing function: {} from {}", functionName, moduleName);
+		}
+		return nullptr;
+	}
+	Py_INCREF(pFunc);
+	return pFunc;
+}
+
 /* Similar to RunFunction, but with parameters, and doesn't necessarily fail */
 PyObject* GUIScript::RunPyFunction(const char* Modulename, const char* FunctionName, const FunctionParameters& params, bool report_error)
 {
 	size_t size = params.size();
-	
+#if PY_VERSION_HEX >= 0x03090000
+	if (!Py_IsInitialized()) {
+		return NULL;
+	}
+	PROFILE_ZONE(GUIScript);
+	Profiler::Count(ProfileCounter::PythonCalls);
+
+	PyObject* pFunc = ResolveFunction(Modulename, FunctionName, report_error);
+	if (!pFunc) {
+		return NULL;
+	}
+
+	// vectorcall spares us the argument tuple; almost all calls pass only a few
+	PyObject* fewArgs[4];
+	std::vector<PyObject*> manyArgs;
+	PyObject** args = fewArgs;
+	if (size > 4) {
+		manyArgs.resize(size);
+		args = manyArgs.data();
+	}
+	for (size_t i = 0; i < size; ++i) {
+		args[i] = ParamToPython(params[i]);
+		if (!args[i]) {
+			args[i] = Py_None;
+			Py_INCREF(Py_None);
+		}
+	}
+
+	PyObject* pValue = PyObject_Vectorcall(pFunc, args, size, nullptr);
+	if (!pValue && PyErr_Occurred()) {
+		PyErr_Print();
+	}
+	for (size_t i = 0; i < size; ++i) {
+		Py_DECREF(args[i]);
+	}
+	Py_DECREF(pFunc);
+	return pValue;
+#else
 	if (size) {
 		auto pyParams = DecRef(PyTuple_New, size);
 
@@ -13599,6 +13687,7 @@ PyObject* GUIScript::RunPyFunction(const char* Modulename, const char* FunctionN
 	} else {
 		return RunPyFunction(Modulename, FunctionName, nullptr, report_error);
 	}
+#endif
 }
 
 PyObject *GUIScript::RunPyFunction(const char* moduleName, const char* functionName, PyObject* pArgs, bool report_error)
@@ -13606,28 +13695,11 @@ PyObject *GUIScript::RunPyFunction(const char* moduleName, const char* functionN
 	if (!Py_IsInitialized()) {
 		return NULL;
 	}
+	PROFILE_ZONE(GUIScript);
+	Profiler::Count(ProfileCounter::PythonCalls);
 
-	PyObject *pyModule;
-	if (moduleName) {
-		pyModule = PyImport_ImportModule(moduleName);
-	} else {
-		pyModule = pModule;
-		Py_XINCREF(pyModule);
-	}
-	if (!pyModule) {
-		PyErr_Print();
-		return NULL;
-	}
-	PyObject *dict = PyModule_GetDict(pyModule);
-
-	PyObject *pFunc = PyDict_GetItemString(dict, functionName);
-	
-	/* pFunc: Borrowed reference */
-	if (!PyCallable_Check(pFunc)) {
-		if (report_error) {
-			Log(ERROR, "GUIScript", "Missing function: {} from {}", functionName, moduleName);
-		}
-		Py_DECREF(pyModule);
+	PyObject* pFunc = ResolveFunction(moduleName, functionName, report_error);
+	if (!pFunc) {
 		return NULL;
 	}
 	PyObject *pValue = PyObject_CallObject( pFunc, pArgs );
@@ -13636,7 +13708,7 @@ PyObject *GUIScript::RunPyFunction(const char* moduleName, const char* functionN
 			PyErr_Print();
 		}
 	}
-	Py_DECREF(pyModule);
+	Py_DECREF(pFunc);
 	return pValue;
 }
 
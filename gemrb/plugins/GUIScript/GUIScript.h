@@ -25,6 +25,9 @@
 #include <Python.h>
 #include "ScriptEngine.h"
 
+#include <string>
+#include <unordered_map>
+
 namespace GemRB {
 
 class View;
@@ -45,6 +48,16 @@ private:
 	PyObject* pMainDic = nullptr; // borrowed, but used outside a function
 	PyObject* pGUIClasses = nullptr;
 
+	// modules and interned names of the functions run by name, so we don't import them on every call
+	struct CachedFunction {
+		PyObject* module = nullptr;
+		PyObject* name = nullptr;
+	};
+	std::unordered_map<std::string, CachedFunction> functionCache;
+
+	PyObject* ResolveFunction(const char* moduleName, const char* functionName, bool report_error);
+	void ClearFunctionCache();
+
 public:
 	GUIScript(void);
 	GUIScript(const GUIScript&) = delete;
@@ -23,6 +23,7 @@
 #include "GUIScript.h"
 
 #include "Callback.h"
+#include "Profiler.h"
 
 #include "GUI/Control.h"
 #include "GUI/GUIScriptInterface.h"
@@ -42,6 +43,8 @@ bool CallPython(PyObject* function, PyObject* args = NULL, R* retVal = NULL)
 		return false;
 	}
 
+	PROFILE_ZONE(GUIScript);
+	Profiler::Count(ProfileCounter::PythonCalls);
 	PyObject *ret = PyObject_CallObject(function, args);
 	Py_XDECREF( args );
 	if (ret == NULL) {
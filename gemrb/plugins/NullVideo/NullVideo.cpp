@@ -0,0 +1,58 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "NullVideo.h"
+
+#include "Sprite2D.h"
+
+using namespace GemRB;
+
+class NullVideoBuffer : public VideoBuffer {
+public:
+	using VideoBuffer::VideoBuffer;
+
+	void Clear(const Region&) override {}
+	void CopyPixels(const Region&, const void*, const int*, ...) override {}
+	bool RenderOnDisplay(void*) const override { return true; }
+};
+
+Holder<Sprite2D> NullVideoDriver::CreateSprite(const Region& rgn, void* pixels, const PixelFormat& fmt)
+{
+	// the generic sprite is enough, since nothing gets rendered
+	return MakeHolder<Sprite2D>(rgn, pixels, fmt);
+}
+
+Holder<Sprite2D> NullVideoDriver::GetScreenshot(Region r, const VideoBufferPtr& buf)
+{
+	if (r.size.IsInvalid()) {
+		r.size = buf ? buf->Size() : screenSize;
+	}
+	void* pixels = calloc(r.w * r.h, 4);
+	return CreateSprite(Region(Point(), r.size), pixels, PixelFormat::ARGB32Bit());
+}
+
+VideoBuffer* NullVideoDriver::NewVideoBuffer(const Region& rgn, BufferFormat)
+{
+	return new NullVideoBuffer(rgn);
+}
+
+#include "plugindef.h"
+
+GEMRB_PLUGIN(0x1D6F6E42, "Null Video Driver")
+PLUGIN_DRIVER(NullVideoDriver, "none")
+END_PLUGIN()
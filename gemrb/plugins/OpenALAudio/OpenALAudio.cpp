@@ -24,6 +24,7 @@
 #include "Interface.h"
 #include "Logging/Logging.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 
@@ -99,6 +100,39 @@ void OpenALSoundHandle::StopLooping() {
 	parent->StopLooping();
 }
 
+StreamFeed::~StreamFeed()
+{
+	if (!buffers.empty()) {
+		alDeleteBuffers(ALsizei(buffers.size()), buffers.data());
+		checkALError("Failed to delete stream buffers", WARNING);
+	}
+}
+
+bool StreamFeed::Done()
+{
+	std::lock_guard<std::mutex> l(mutex);
+	return finished || cancelled;
+}
+
+void StreamFeed::Cancel()
+{
+	std::shared_ptr<StreamFeed> prev;
+	{
+		std::lock_guard<std::mutex> l(mutex);
+		cancelled = true;
+		prev = std::move(previous);
+	}
+	if (prev) {
+		prev->Cancel();
+	}
+}
+
+void AudioStream::CancelFeed() const {
+	if (feed) {
+		feed->Cancel();
+	}
+}
+
 void AudioStream::ClearProcessedBuffers() const {
 	if (sources.first) {
 		ClearProcessedBuffers(sources.first);
@@ -108,7 +142,8 @@ void AudioStream::ClearProcessedBuffers() const {
 	}
 }
 
-void AudioStream::ClearProcessedBuffers(ALuint Source) const
+// the buffers are only deleted when the stream owns them, otherwise they belong to the cache or a feed
+static void UnqueueProcessedBuffers(ALuint Source, bool deleteBuffers)
 {
 	ALint processed = 0;
 	alGetSourcei( Source, AL_BUFFERS_PROCESSED, &processed );
@@ -119,7 +154,7 @@ void AudioStream::ClearProcessedBuffers(ALuint Source) const
 		alSourceUnqueueBuffers( Source, processed, b );
 		checkALError("Failed to unqueue buffers", WARNING);
 
-		if (delete_buffers) {
+		if (deleteBuffers) {
 #ifdef __APPLE__ // mac os x and iOS
 			/* FIXME: hackish
 				somebody with more knowledge than me could perhapps figure out
@@ -140,8 +175,15 @@ void AudioStream::ClearProcessedBuffers(ALuint Source) const
 
 }
 
+void AudioStream::ClearProcessedBuffers(ALuint Source) const
+{
+	UnqueueProcessedBuffers(Source, delete_buffers);
+}
+
 void AudioStream::ClearIfStopped() {
 	if (free || locked) return;
+	// an underrun stops the source too, the decoder restarts it with the next chunk
+	if (feed && !feed->Done()) return;
 
 	bool sourceDeleted = ClearIfStopped(sources.first);
 	if (sources.second) {
@@ -155,6 +197,7 @@ void AudioStream::ClearIfStopped() {
 		ambient = false;
 		sources = {0, 0};
 		buffers = {0, 0};
+		feed.reset();
 		if (handle) {
 			handle->Invalidate();
 			handle.reset();
@@ -193,6 +236,7 @@ void AudioStream::Stop() const {
 
 void AudioStream::ForceClear()
 {
+	CancelFeed();
 	Stop();
 	ClearProcessedBuffers();
 	ClearIfStopped();
@@ -310,6 +354,7 @@ bool OpenALAudioDriver::Init(void)
 		num_streams, (num_streams < MAX_STREAMS ? " (Fewer than desired.)" : "" ));
 
 	musicThread = std::thread(&OpenALAudioDriver::MusicManager, this);
+	decoderThread = std::thread(&OpenALAudioDriver::DecoderLoop, this);
 
 	if (!InitEFX()) {
 		Log(MESSAGE, "OpenAL", "EFX not available.");
@@ -414,6 +459,13 @@ OpenALAudioDriver::~OpenALAudioDriver(void)
 	
 	// AmigaOS4 should be built with -athread=native or this may not work
 	musicThread.join();
+	{
+		std::lock_guard<std::mutex> l(decodeMutex);
+	}
+	decodeCond.notify_all();
+	decoderThread.join();
+	decodeQueue.clear();
+	prefetchQueue.clear();
 
 	for(int i =0; i<num_streams; i++) {
 		streams[i].ForceClear();
@@ -444,7 +496,28 @@ OpenALAudioDriver::~OpenALAudioDriver(void)
 	delete ambim;
 }
 
-std::pair<ALuint, ALuint> OpenALAudioDriver::loadSound(StringView ResRef, tick_t &time_length, bool spatial)
+ALuint OpenALAudioDriver::CreateBuffer(const short* data, size_t bytes, int channels, int samplerate) const
+{
+	ALuint buffer = 0;
+	alGenBuffers(1, &buffer);
+	if (checkALError("Unable to create sound buffer", ERROR)) {
+		return 0;
+	}
+
+	//it is always reading the stuff into 16 bits
+	alBufferData(buffer, GetFormatEnum(channels, 16), data, ALsizei(bytes), samplerate);
+	if (checkALError("Unable to fill buffer", ERROR)) {
+		alDeleteBuffers(1, &buffer);
+		checkALError("Error deleting buffer", WARNING);
+		return 0;
+	}
+
+	return buffer;
+}
+
+// cacheLock is released while decoding, but held again when valid buffers are returned
+std::pair<ALuint, ALuint> OpenALAudioDriver::loadSound(StringView ResRef, tick_t &time_length, std::unique_lock<std::mutex>& cacheLock,
+	bool spatial, DecodeJob* stream)
 {
 	if (ResRef.empty()) {
 		return {0, 0};
@@ -455,8 +528,7 @@ std::pair<ALuint, ALuint> OpenALAudioDriver::loadSound(StringView ResRef, tick_t
 		time_length = entry->Length;
 		return entry->Buffer;
 	}
-
-	ALuint buffers[2] = {0, 0};
+	cacheLock.unlock();
 
 	ResourceHolder<SoundMgr> acm = gamedata->GetResourceHolder<SoundMgr>(ResRef);
 	if (!acm) {
@@ -467,18 +539,44 @@ std::pair<ALuint, ALuint> OpenALAudioDriver::loadSound(StringView ResRef, tick_t
 	assert(channels <= 2);
 	bool spatialStereo = channels > 1 && spatial;
 
-	alGenBuffers(spatialStereo ? 2 : 1, buffers);
-	if (checkALError("Unable to create sound buffer", ERROR)) {
-		return {0, 0};
-	}
-
 	int samplerate = acm->get_samplerate();
 	auto numSamples = acm->get_length();
 	auto totalBytesPerChannel = numSamples * 2;
 
+	// Sound length in milliseconds
+	time_length = ((numSamples / channels) * 1000) / samplerate;
+
+	// long sounds only wait for a short first chunk, the decoder thread queues the rest
+	if (stream && !spatialStereo && time_length > STREAM_MIN_LENGTH) {
+		int chunk = samplerate * channels * STREAM_FIRST_CHUNK / 1000;
+		stream->decoded.resize(chunk);
+		int cnt = acm->read_samples(stream->decoded.data(), chunk);
+		stream->decoded.resize(std::max(cnt, 0));
+
+		ALuint buffer = CreateBuffer(stream->decoded.data(), stream->decoded.size() * 2, channels, samplerate);
+		if (buffer == 0) {
+			return {0, 0};
+		}
+
+		stream->resRef = ResRef.c_str();
+		stream->reader = std::move(acm);
+		stream->feed = std::make_shared<StreamFeed>();
+		stream->feed->buffers.push_back(buffer);
+		cacheLock.lock();
+		return {buffer, 0};
+	}
+
+	ALuint buffers[2] = {0, 0};
+	size_t bytes = 0;
+
 	// Positional sound doesn't work for stereo in all known implementations
 	// so make two sources and play them in parallel: https://openal.org/pipermail/openal/2016-August/000527.html
 	if (spatialStereo) {
+		alGenBuffers(2, buffers);
+		if (checkALError("Unable to create sound buffer", ERROR)) {
+			return {0, 0};
+		}
+
 		std::vector<char> channel1;
 		std::vector<char> channel2;
 		channel1.resize(totalBytesPerChannel);
@@ -488,28 +586,33 @@ std::pair<ALuint, ALuint> OpenALAudioDriver::loadSound(StringView ResRef, tick_t
 		auto format = GetFormatEnum(1, 16);
 		alBufferData(buffers[0], format, channel1.data(), actualSamples * 2, samplerate);
 		alBufferData(buffers[1], format, channel2.data(), actualSamples * 2, samplerate);
+		bytes = actualSamples * 4;
+
+		if (checkALError("Unable to fill buffer", ERROR)) {
+			alDeleteBuffers(2, buffers);
+			checkALError("Error deleting buffer", WARNING);
+			return {0, 0};
+		}
 	} else {
 		short* memory = (short*) malloc(totalBytesPerChannel);
 		//multiply always with 2 because it is in 16 bits
 		unsigned int cnt1 = acm->read_samples(memory, numSamples) * 2;
-		//it is always reading the stuff into 16 bits
-		alBufferData(buffers[0], GetFormatEnum(channels, 16), memory, cnt1, samplerate);
+		buffers[0] = CreateBuffer(memory, cnt1, channels, samplerate);
 		free(memory);
-	}
+		bytes = cnt1;
 
-	// Sound length in milliseconds
-	time_length = ((numSamples / channels) * 1000) / samplerate;
-
-	if (checkALError("Unable to fill buffer", ERROR)) {
-		alDeleteBuffers(spatialStereo ? 2 : 1, buffers);
-		checkALError("Error deleting buffer", WARNING);
-		return {0, 0};
+		if (buffers[0] == 0) {
+			return {0, 0};
+		}
 	}
 
 	std::pair<ALuint, ALuint> bufferPair {buffers[0], buffers[1]};
-	buffercache.SetAt(ResRef, bufferPair, time_length);
-
-	return bufferPair;
+	cacheLock.lock();
+	// the decoder or ambient thread may have cached it in the meantime,
+	// then our copy is deleted right away and we use theirs
+	const CacheEntry* cached = buffercache.SetAt(ResRef, bufferPair, time_length, bytes);
+	time_length = cached->Length;
+	return cached->Buffer;
 }
 
 Holder<SoundHandle> OpenALAudioDriver::Play(StringView ResRef, SFXChannel channel, const Point& p,
@@ -519,6 +622,7 @@ Holder<SoundHandle> OpenALAudioDriver::Play(StringView ResRef, SFXChannel channe
 		auto source = speech.sources.first;
 		if ((flags & GEM_SND_SPEECH) && (source && alIsSource(source))) {
 			//So we want him to be quiet...
+			speech.CancelFeed();
 			alSourceStop(source);
 			checkALError("Unable to stop speech", WARNING);
 			speech.ClearProcessedBuffers();
@@ -526,8 +630,19 @@ Holder<SoundHandle> OpenALAudioDriver::Play(StringView ResRef, SFXChannel channe
 		return Holder<SoundHandle>();
 	}
 
+	if ((flags & GEM_SND_SPEECH) && (flags & GEM_SND_QUEUE) && !speech.free && speech.feed && !speech.feed->Done()) {
+		// queue behind the complete previous line, not in between its chunks
+		return ChainSpeech(ResRef, channel, p, flags, length);
+	}
+
+	// held until the buffers are queued, so they can't get evicted in the meantime
+	std::unique_lock<std::mutex> cacheLock(cacheMutex);
+
+	// looping and queued sounds need all their data up front
+	bool streamable = !(flags & (GEM_SND_LOOPING | GEM_SND_QUEUE));
+	DecodeJob job;
 	tick_t time_length;
-	auto buffers = loadSound(ResRef, time_length, flags & GEM_SND_SPATIAL);
+	auto buffers = loadSound(ResRef, time_length, cacheLock, flags & GEM_SND_SPATIAL, streamable ? &job : nullptr);
 	if (buffers.first == 0) {
 		return Holder<SoundHandle>();
 	}
@@ -550,10 +665,12 @@ Holder<SoundHandle> OpenALAudioDriver::Play(StringView ResRef, SFXChannel channe
 
 			auto source = speech.sources.first;
 			if (!speech.free && (source && alIsSource(source))) {
+				speech.CancelFeed();
 				alSourceStop(source);
 				checkALError("Unable to stop speech", WARNING);
 				speech.ClearProcessedBuffers();
 			}
+			speech.feed.reset();
 		}
 
 		volume = core->GetDictionary().Get("Volume Voices", 100);
@@ -593,6 +710,12 @@ Holder<SoundHandle> OpenALAudioDriver::Play(StringView ResRef, SFXChannel channe
 		return Holder<SoundHandle>();
 	}
 
+	if (job.feed) {
+		job.feed->sources = stream->sources;
+		stream->feed = job.feed;
+		SubmitDecode(std::move(job));
+	}
+
 	stream->handle = MakeHolder<OpenALSoundHandle>(stream);
 	return stream->handle;
 }
@@ -881,8 +1004,9 @@ tick_t OpenALAudioDriver::QueueAmbient(int streamIdx, const ResRef& sound)
 	// first dequeue any processed buffers
 	stream.ClearProcessedBuffers();
 
+	std::unique_lock<std::mutex> cacheLock(cacheMutex);
 	tick_t time_length;
-	ALuint Buffer = loadSound(sound, time_length).first;
+	ALuint Buffer = loadSound(sound, time_length, cacheLock).first;
 	if (0 == Buffer) {
 		return -1;
 	}
@@ -934,6 +1058,7 @@ ALenum OpenALAudioDriver::GetFormatEnum(int channels, int bits) const
 
 int OpenALAudioDriver::MusicManager(void* arg)
 {
+	TRACY(tracy::SetThreadName("Music"));
 	OpenALAudioDriver* driver = (OpenALAudioDriver*) arg;
 	ALboolean bFinished = AL_FALSE;
 	while (driver->stayAlive) {
@@ -1067,9 +1192,179 @@ void OpenALAudioDriver::QueueBuffer(int streamIdx, unsigned short bits,
 	QueueALBuffers({stream.sources.first, 0}, {Buffer, 0});
 }
 
+void OpenALAudioDriver::Prefetch(StringView ResRef)
+{
+	if (ResRef.empty()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> l(cacheMutex);
+		if (buffercache.Lookup(ResRef)) {
+			return;
+		}
+	}
+
+	DecodeJob job;
+	job.resRef = ResRef.c_str();
+	{
+		std::lock_guard<std::mutex> l(decodeMutex);
+		if (pendingDecodes.count(job.resRef)) {
+			return;
+		}
+	}
+
+	// the decoder thread opens the resource too, so area loads don't wait for all the lookups
+	SubmitDecode(std::move(job));
+}
+
+void OpenALAudioDriver::SubmitDecode(DecodeJob&& job)
+{
+	{
+		std::lock_guard<std::mutex> l(decodeMutex);
+		pendingDecodes.insert(job.resRef);
+		if (job.feed) {
+			decodeQueue.push_back(std::move(job));
+		} else {
+			prefetchQueue.push_back(std::move(job));
+		}
+	}
+	decodeCond.notify_one();
+}
+
+// the decoder thread handles stream jobs in order, so the chained line's chunks
+// are only queued after all of the previous line's, without waiting for it here
+Holder<SoundHandle> OpenALAudioDriver::ChainSpeech(StringView ResRef, SFXChannel channel, const Point& p, unsigned int flags, tick_t* length)
+{
+	DecodeJob job;
+	job.reader = gamedata->GetResourceHolder<SoundMgr>(ResRef);
+	if (!job.reader) {
+		return Holder<SoundHandle>();
+	}
+
+	if (length) {
+		*length = ((job.reader->get_length() / job.reader->get_channels()) * 1000) / job.reader->get_samplerate();
+	}
+
+	ieDword volume = core->GetDictionary().Get("Volume Voices", 100);
+	ConfigSource(speech.sources.first, volume, 0, flags, p, channel);
+
+	job.resRef = ResRef.c_str();
+	job.feed = std::make_shared<StreamFeed>();
+	job.feed->sources = {speech.sources.first, 0};
+	job.feed->previous = speech.feed;
+	speech.feed = job.feed;
+	SubmitDecode(std::move(job));
+
+	speech.handle = MakeHolder<OpenALSoundHandle>(&speech);
+	return speech.handle;
+}
+
+void OpenALAudioDriver::DecoderLoop()
+{
+	TRACY(tracy::SetThreadName("Audio decoder"));
+	while (true) {
+		DecodeJob job;
+		{
+			std::unique_lock<std::mutex> l(decodeMutex);
+			decodeCond.wait(l, [this]() { return !stayAlive || !decodeQueue.empty() || !prefetchQueue.empty(); });
+			if (!stayAlive) {
+				return;
+			}
+			std::deque<DecodeJob>& queue = decodeQueue.empty() ? prefetchQueue : decodeQueue;
+			job = std::move(queue.front());
+			queue.pop_front();
+		}
+
+		if (!job.reader) {
+			job.reader = gamedata->GetResourceHolder<SoundMgr>(job.resRef);
+		}
+		if (job.reader) {
+			Decode(job);
+		}
+
+		std::lock_guard<std::mutex> l(decodeMutex);
+		pendingDecodes.erase(job.resRef);
+	}
+}
+
+// runs on the decoder thread: feeds a playing stream chunk by chunk and caches the whole sound
+void OpenALAudioDriver::Decode(DecodeJob& job)
+{
+	int channels = job.reader->get_channels();
+	int samplerate = job.reader->get_samplerate();
+	std::vector<short>& decoded = job.decoded;
+	decoded.reserve(job.reader->get_length());
+
+	int chunk = samplerate * channels * STREAM_CHUNK / 1000;
+	while (true) {
+		size_t pos = decoded.size();
+		decoded.resize(pos + chunk);
+		int cnt = job.reader->read_samples(decoded.data() + pos, chunk);
+		decoded.resize(pos + std::max(cnt, 0));
+		if (cnt <= 0) {
+			break;
+		}
+
+		if (job.feed) {
+			StreamFeed& feed = *job.feed;
+			std::lock_guard<std::mutex> l(feed.mutex);
+			if (feed.cancelled) {
+				// nobody is listening anymore, don't bother caching it either
+				return;
+			}
+
+			ALuint buffer = CreateBuffer(decoded.data() + pos, cnt * 2, channels, samplerate);
+			if (buffer) {
+				feed.buffers.push_back(buffer);
+				QueueALBuffers({feed.sources.first, 0}, {buffer, 0});
+			}
+		}
+
+		if (cnt < chunk) {
+			break;
+		}
+	}
+
+	if (job.feed) {
+		std::lock_guard<std::mutex> l(job.feed->mutex);
+		job.feed->finished = true;
+		job.feed->previous.reset();
+	}
+
+	if (decoded.empty()) {
+		return;
+	}
+
+	size_t bytes = decoded.size() * 2;
+	ALuint buffer = CreateBuffer(decoded.data(), bytes, channels, samplerate);
+	if (buffer == 0) {
+		return;
+	}
+
+	tick_t length = ((decoded.size() / channels) * 1000) / samplerate;
+	std::lock_guard<std::mutex> l(cacheMutex);
+	// if loadSound got there first, only our own buffer is dropped again
+	buffercache.SetAt(job.resRef, std::make_pair(buffer, ALuint(0)), length, bytes);
+}
+
 int OpenALAudioDriver::QueueALBuffers(OpenALuintPair sources, OpenALuintPair buffers) const
 {
 	ALenum state;
+	alGetSourcei(sources.first, AL_SOURCE_STATE, &state);
+	if (checkALError("Unable to query source state", ERROR)) {
+		return GEM_ERROR;
+	}
+
+	// after an underrun or the end of the queue everything queued counts as processed,
+	// so drop it first, otherwise playing would replay it instead of resuming with the new data
+	if (state == AL_STOPPED) {
+		UnqueueProcessedBuffers(sources.first, false);
+		if (sources.second) {
+			UnqueueProcessedBuffers(sources.second, false);
+		}
+	}
+
 	auto result = QueueALBuffer(sources.first, buffers.first);
 	if (result == GEM_ERROR) {
 		return GEM_ERROR;
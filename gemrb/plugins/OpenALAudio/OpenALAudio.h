@@ -32,9 +32,14 @@
 #include "SoundMgr.h"
 #include "Streams/FileStream.h"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #if __APPLE__
 #include <OpenAL/OpenAL.h> // umbrella include for all the headers we want
@@ -47,7 +52,12 @@
 #endif
 
 #define RETRY 5
-#define BUFFER_CACHE_SIZE 100
+#define BUFFER_CACHE_SIZE 500
+#define BUFFER_CACHE_BYTES (32 * 1024 * 1024)
+// longer sounds start playing after the first chunk is decoded
+#define STREAM_MIN_LENGTH 2000
+#define STREAM_FIRST_CHUNK 250
+#define STREAM_CHUNK 1000
 #define MAX_STREAMS 30
 #define MUSICBUFFERS 10
 #define REFERENCE_DISTANCE 50
@@ -72,6 +82,26 @@ public:
 
 using OpenALuintPair = std::pair<ALuint, ALuint>;
 
+// shared by a playing stream and the decoder thread that keeps queueing to it
+struct StreamFeed {
+	std::mutex mutex;
+	OpenALuintPair sources = {0, 0};
+	// the chunk buffers belong to the feed, the cache never sees them
+	std::vector<ALuint> buffers;
+	// a queued speech line is chained behind the feed still playing, so stopping cancels both
+	std::shared_ptr<StreamFeed> previous;
+	bool cancelled = false;
+	bool finished = false;
+
+	StreamFeed() noexcept = default;
+	StreamFeed(const StreamFeed&) = delete;
+	StreamFeed& operator=(const StreamFeed&) = delete;
+	~StreamFeed();
+
+	bool Done();
+	void Cancel();
+};
+
 struct AudioStream {
 	// Spatial stereo is laid out as two sources and buffers,
 	// for every other case, just the first value is relevant.
@@ -82,7 +112,9 @@ struct AudioStream {
 	bool ambient = false;
 	bool locked = false;
 	bool delete_buffers = false;
+	std::shared_ptr<StreamFeed> feed;
 
+	void CancelFeed() const;
 	void ClearIfStopped();
 	bool ClearIfStopped(ALuint source);
 	void ClearProcessedBuffers() const;
@@ -101,10 +133,11 @@ struct AudioStream {
 struct CacheEntry {
 	OpenALuintPair Buffer;
 	tick_t Length;
+	size_t Bytes;
 
-	CacheEntry(OpenALuintPair buffer, tick_t length) : Buffer(buffer), Length(length) {}
+	CacheEntry(OpenALuintPair buffer, tick_t length, size_t bytes) : Buffer(buffer), Length(length), Bytes(bytes) {}
 	CacheEntry(const CacheEntry&) = delete;
-	CacheEntry(CacheEntry && other) noexcept : Buffer(other.Buffer), Length(other.Length) {
+	CacheEntry(CacheEntry && other) noexcept : Buffer(other.Buffer), Length(other.Length), Bytes(other.Bytes) {
 		other.Buffer = {0, 0};
 	}
 	CacheEntry& operator=(const CacheEntry&) = delete;
@@ -112,6 +145,7 @@ struct CacheEntry {
 		this->Buffer = other.Buffer;
 		other.Buffer = {0, 0};
 		this->Length = other.Length;
+		this->Bytes = other.Bytes;
 
 		return *this;
 	}
@@ -141,6 +175,23 @@ struct OpenALPlaying {
 	}
 };
 
+struct OpenALBufferSize {
+	size_t operator()(const CacheEntry& entry) const {
+		return entry.Bytes;
+	}
+};
+
+// a sound to finish decoding on the decoder thread
+struct DecodeJob {
+	std::string resRef;
+	// opened by the decoder thread for prefetches
+	ResourceHolder<SoundMgr> reader;
+	// what was already decoded for a fast start, so the cached copy is complete
+	std::vector<short> decoded;
+	// set when the job keeps a playing stream supplied, otherwise it is a prefetch
+	std::shared_ptr<StreamFeed> feed;
+};
+
 class OpenALAudioDriver : public Audio {
 public:
 	OpenALAudioDriver(void);
@@ -170,6 +221,7 @@ public:
 				int channels, short* memory,
 				int size, int samplerate) override;
 	void UpdateMapAmbient(const MapReverbProperties&) override;
+	void Prefetch(StringView ResRef) override;
 private:
 	int QueueALBuffers(OpenALuintPair source, OpenALuintPair buffer) const;
 	int QueueALBuffer(ALuint source, ALuint buffer) const;
@@ -181,7 +233,9 @@ private:
 	std::recursive_mutex musicMutex;
 	ALuint MusicBuffer[MUSICBUFFERS]{};
 	ResourceHolder<SoundMgr> MusicReader;
-	LRUCache<CacheEntry, OpenALPlaying> buffercache{BUFFER_CACHE_SIZE};
+	// guards the buffer cache, which is used by the game, ambient and decoder threads
+	std::mutex cacheMutex;
+	LRUCache<CacheEntry, OpenALPlaying, OpenALBufferSize> buffercache{BUFFER_CACHE_SIZE, BUFFER_CACHE_BYTES};
 	AudioStream speech;
 	AudioStream streams[MAX_STREAMS];
 	int num_streams = 0;
@@ -190,13 +244,27 @@ private:
 	short* music_memory;
 	std::thread musicThread;
 
+	std::mutex decodeMutex;
+	std::condition_variable decodeCond;
+	// jobs feeding playing streams are handled before any prefetches
+	std::deque<DecodeJob> decodeQueue;
+	std::deque<DecodeJob> prefetchQueue;
+	std::unordered_set<std::string> pendingDecodes;
+	std::thread decoderThread;
+
 	bool hasReverbProperties = false;
 	bool hasEFX = false;
 	ALuint efxEffectSlot = 0;
 	ALuint efxEffect = 0;
 	MapReverbProperties reverbProperties;
 
-	OpenALuintPair loadSound(StringView ResRef, tick_t &time_length, bool spatial = false);
+	OpenALuintPair loadSound(StringView ResRef, tick_t &time_length, std::unique_lock<std::mutex>& cacheLock,
+				bool spatial = false, DecodeJob* stream = nullptr);
+	ALuint CreateBuffer(const short* data, size_t bytes, int channels, int samplerate) const;
+	void SubmitDecode(DecodeJob&& job);
+	Holder<SoundHandle> ChainSpeech(StringView ResRef, SFXChannel channel, const Point& p, unsigned int flags, tick_t* length);
+	void Decode(DecodeJob& job);
+	void DecoderLoop();
 	int CountAvailableSources(int limit);
 	bool evictBuffer();
 	void clearBufferCache(bool force);
@@ -94,7 +94,7 @@ int SAVImporter::CreateArchive(DataStream *compressed)
 	return GEM_OK;
 }
 
-int SAVImporter::AddToSaveGame(DataStream *str, DataStream *uncompressed)
+int SAVImporter::AddToSaveGame(DataStream *str, DataStream *uncompressed, int level)
 {
 	size_t fnlen = uncompressed->filename.length() + 1;
 	strpos_t declen = uncompressed->Size();
@@ -108,7 +108,7 @@ int SAVImporter::AddToSaveGame(DataStream *str, DataStream *uncompressed)
 	str->WriteDword(complen);
 
 	PluginHolder<Compressor> comp = MakePluginHolder<Compressor>(PLUGIN_COMPRESSION_ZLIB);
-	comp->Compress( str, uncompressed );
+	comp->Compress(str, uncompressed, level);
 
 	//writing compressed length (calculated)
 	strpos_t Pos2 = str->GetPos();
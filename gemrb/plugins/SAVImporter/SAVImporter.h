@@ -33,7 +33,7 @@ class SAVImporter : public ArchiveImporter {
 public:
 	SAVImporter() noexcept = default;
 	int DecompressSaveGame(DataStream *compressed, SaveGameAREExtractor&) override;
-	int AddToSaveGame(DataStream *str, DataStream *uncompressed) override;
+	int AddToSaveGame(DataStream *str, DataStream *uncompressed, int level) override;
 	int AddToSaveGameCompressed(DataStream *str, DataStream *compressed) override;
 	int CreateArchive(DataStream *compressed) override;
 };
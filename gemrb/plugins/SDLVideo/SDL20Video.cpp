@@ -22,6 +22,7 @@
 
 #include "Audio.h"
 #include "Interface.h"
+#include "Profiler.h"
 
 #ifdef USE_TRACY
 #include <tracy/TracyOpenGL.hpp>
@@ -393,14 +394,31 @@ int SDL20VideoDriver::UpdateRenderTarget(const Color* color, BlitFlags flags)
 
 void SDL20VideoDriver::BlitSpriteNativeClipped(const SDLTextureSprite2D* spr, const Region& src, const Region& dst, BlitFlags flags, const SDL_Color* tint)
 {
+	const SDLTextureSprite2D* sheet = spr->GetSheet();
+	if (sheet) {
+		// a sub-rect of the shared texture, so the frame never needs one of its own
+		flags &= ~sheet->PrepareForRendering(flags, reinterpret_cast<const Color*>(tint));
+		Region sheetSrc = src;
+		sheetSrc.origin += spr->SheetPos();
+		BlitSpriteNativeClipped(sheet->GetTexture(renderer), sheetSrc, dst, flags, tint);
+		return;
+	}
+
 	flags &= ~spr->PrepareForRendering(flags, reinterpret_cast<const Color*>(tint));
 	SDL_Texture* tex = spr->GetTexture(renderer);
 	BlitSpriteNativeClipped(tex, src, dst, flags, tint);
 }
 
+Holder<Sprite2D> SDL20VideoDriver::CreateSheetFrame(const Holder<Sprite2D>& sheet, const Region& frame, const Point& pos)
+{
+	assert(Region(Point(), sheet->Frame.size).RectInside(Region(pos, frame.size)));
+	return MakeHolder<sprite_t>(frame, std::static_pointer_cast<const sprite_t>(sheet), pos);
+}
+
 void SDL20VideoDriver::BlitSpriteNativeClipped(SDL_Texture* texSprite, const Region& srgn, const Region& drgn, BlitFlags flags, const SDL_Color* tint)
 {
 	TRACY(ZoneScoped);
+	Profiler::Count(ProfileCounter::DrawCalls);
 	SDL_Rect srect = RectFromRegion(srgn);
 	SDL_Rect drect = RectFromRegion(drgn);
 	
@@ -492,8 +510,9 @@ int SDL20VideoDriver::RenderCopyShaded(SDL_Texture* texture, const SDL_Rect* src
 
 	blitRGBAShader->SetUniformValue("u_greyMode", 1, greyMode);
 
-	blitRGBAShader->SetUniformValue("u_brightness", 1, brightness);
-	blitRGBAShader->SetUniformValue("u_contrast", 1, contrast);
+	bool doGamma = !(flags & BlitFlags::NO_GAMMA);
+	blitRGBAShader->SetUniformValue("u_brightness", 1, doGamma ? brightness : 1.0f);
+	blitRGBAShader->SetUniformValue("u_contrast", 1, doGamma ? contrast : 1.0f);
 
 	GLint channel = 3;
 	if (flags & BlitFlags::STENCIL_RED) {
@@ -693,6 +712,56 @@ void SDL20VideoDriver::DrawLineImp(const Point& p1, const Point& p2, const Color
 	SDL_RenderDrawLine(renderer, p1.x, p1.y, p2.x, p2.y);
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+// two triangles covering the pixels from p1 to p2, widened by one pixel across the dominant axis
+static void AddPixelQuad(std::vector<SDL_Vertex>& vertices, Point p1, Point p2, const Color& color)
+{
+	bool steep = std::abs(p2.y - p1.y) >= std::abs(p2.x - p1.x);
+	if ((steep && p1.y > p2.y) || (!steep && p1.x > p2.x)) {
+		std::swap(p1, p2);
+	}
+
+	SDL_FPoint corners[4];
+	if (steep) {
+		corners[0] = { float(p1.x), float(p1.y) };
+		corners[1] = { float(p1.x + 1), float(p1.y) };
+		corners[2] = { float(p2.x + 1), float(p2.y + 1) };
+		corners[3] = { float(p2.x), float(p2.y + 1) };
+	} else {
+		corners[0] = { float(p1.x), float(p1.y) };
+		corners[1] = { float(p2.x + 1), float(p2.y) };
+		corners[2] = { float(p2.x + 1), float(p2.y + 1) };
+		corners[3] = { float(p1.x), float(p1.y + 1) };
+	}
+
+	const SDL_Color& sdlColor = reinterpret_cast<const SDL_Color&>(color);
+	for (int corner : { 0, 1, 2, 0, 2, 3 }) {
+		vertices.push_back({ corners[corner], sdlColor, { 0.0f, 0.0f } });
+	}
+}
+#endif
+
+void SDL20VideoDriver::DrawPrimitivesImp(const PrimitiveBatch& batch, BlitFlags flags)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	// a single geometry call for the whole batch, regardless of how many colors it uses
+	std::vector<SDL_Vertex>& vertices = primitiveVertices;
+	vertices.clear();
+	vertices.reserve((batch.points.size() + batch.lineColors.size()) * 6);
+	for (size_t i = 0; i < batch.points.size(); ++i) {
+		AddPixelQuad(vertices, batch.points[i], batch.points[i], batch.pointColors[i]);
+	}
+	for (size_t i = 0; i < batch.lineColors.size(); ++i) {
+		AddPixelQuad(vertices, batch.lines[i * 2], batch.lines[i * 2 + 1], batch.lineColors[i]);
+	}
+
+	UpdateRenderTarget(&ColorWhite, flags);
+	SDL_RenderGeometry(renderer, nullptr, vertices.data(), int(vertices.size()), nullptr, 0);
+#else
+	Video::DrawPrimitivesImp(batch, flags);
+#endif
+}
+
 void SDL20VideoDriver::DrawRectImp(const Region& rgn, const Color& color, bool fill, BlitFlags flags)
 {
 	UpdateRenderTarget(&color, flags);
@@ -911,6 +980,7 @@ int SDL20VideoDriver::ProcessEvent(const SDL_Event & event)
 			// fallthrough
 		case SDL_APP_DIDENTERFOREGROUND:
 		case SDL_RENDER_TARGETS_RESET:
+			++bufferGeneration;
 			e = EventMgr::CreateRedrawRequestEvent();
 			EvntManager->DispatchEvent(std::move(e));
 			break;
@@ -225,6 +225,9 @@ private:
 	float brightness = 1.0;
 	float contrast = 1.0;
 	Size customFullscreenSize;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	std::vector<SDL_Vertex> primitiveVertices; // reused by DrawPrimitivesImp
+#endif
 public:
 	SDL20VideoDriver() noexcept;
 	~SDL20VideoDriver() noexcept override;
@@ -245,6 +248,9 @@ public:
 	
 	bool TouchInputEnabled() override;
 	bool CanDrawRawGeometry() const override;
+	bool SupportsRLESprites() const override { return false; }
+	bool SupportsSpriteSheets() const override { return true; }
+	Holder<Sprite2D> CreateSheetFrame(const Holder<Sprite2D>& sheet, const Region& frame, const Point& pos) override;
 
 	void BlitVideoBuffer(const VideoBufferPtr& buf, const Point& p, BlitFlags flags,
 						 Color tint = Color()) override;
@@ -277,6 +283,7 @@ private:
 	void DrawPointsImp(const std::vector<Point>& points, const Color& color, BlitFlags flags) override;
 
 	void DrawPolygonImp(const Gem_Polygon* poly, const Point& origin, const Color& color, bool fill, BlitFlags flags) override;
+	void DrawPrimitivesImp(const PrimitiveBatch& batch, BlitFlags flags) override;
 
 	void BlitSpriteRLEClipped(const Holder<Sprite2D>& /*spr*/, const Region& /*src*/, const Region& /*dst*/,
 							  BlitFlags /*flags*/ = BlitFlags::NONE, const Color* /*tint*/ = NULL) override { assert(false); } // SDL2 does not support this
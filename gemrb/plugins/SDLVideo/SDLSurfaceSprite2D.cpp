@@ -28,11 +28,11 @@
 
 namespace GemRB {
 
-SDLSurfaceSprite2D::SDLSurfaceSprite2D (const Region& rgn, void* px, const PixelFormat& fmt) noexcept
-: Sprite2D(rgn, px, fmt)
+SDLSurfaceSprite2D::SDLSurfaceSprite2D (const Region& rgn, void* px, const PixelFormat& fmt, uint16_t stride) noexcept
+: Sprite2D(rgn, px, fmt, stride)
 {
 	if (px) {
-		surface = SDL_CreateRGBSurfaceFrom(px, Frame.w, Frame.h, fmt.Depth, Frame.w * fmt.Bpp,
+		surface = SDL_CreateRGBSurfaceFrom(px, Frame.w, Frame.h, fmt.Depth, stride,
 										   fmt.Rmask, fmt.Gmask, fmt.Bmask, fmt.Amask);
 	} else {
 		assert(fmt.Depth >= 8);
@@ -52,6 +52,10 @@ SDLSurfaceSprite2D::SDLSurfaceSprite2D (const Region& rgn, void* px, const Pixel
 	format = PixelFormatForSurface(surface, format.palette);
 }
 
+SDLSurfaceSprite2D::SDLSurfaceSprite2D (const Region& rgn, void* px, const PixelFormat& fmt) noexcept
+: SDLSurfaceSprite2D(rgn, px, fmt, rgn.w * fmt.Bpp)
+{}
+
 SDLSurfaceSprite2D::SDLSurfaceSprite2D (const Region& rgn, const PixelFormat& fmt) noexcept
 : SDLSurfaceSprite2D(rgn, nullptr, fmt)
 {}
@@ -294,6 +298,14 @@ SDLTextureSprite2D::SDLTextureSprite2D(const Region& rgn, const PixelFormat& fmt
 : SDLSurfaceSprite2D(rgn, fmt)
 {}
 
+SDLTextureSprite2D::SDLTextureSprite2D(const Region& rgn, Holder<const SDLTextureSprite2D> sht, const Point& pos) noexcept
+: SDLSurfaceSprite2D(rgn, static_cast<uint8_t*>(sht->pixels) + pos.y * sht->pitch + pos.x * sht->format.Bpp, sht->format, sht->pitch),
+sheet(std::move(sht)), sheetPos(pos)
+{
+	// the sheet owns the pixels
+	freePixels = false;
+}
+
 SDLTextureSprite2D::~SDLTextureSprite2D() noexcept
 {
 	SDL_DestroyTexture(texture);
@@ -308,6 +320,15 @@ Holder<Sprite2D> SDLTextureSprite2D::copy() const
 	return Holder<Sprite2D>(new SDLTextureSprite2D(*this));
 }
 
+const SDLTextureSprite2D* SDLTextureSprite2D::GetSheet() const noexcept
+{
+	// SetPalette or a format conversion means we no longer match the sheet
+	if (sheet && format.palette == sheet->format.palette && format.ColorKey == sheet->format.ColorKey) {
+		return sheet.get();
+	}
+	return nullptr;
+}
+
 SDL_Texture* SDLTextureSprite2D::GetTexture(SDL_Renderer* renderer) const
 {
 	if (texture == nullptr) {
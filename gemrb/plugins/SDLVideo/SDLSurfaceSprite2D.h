@@ -58,6 +58,7 @@ private:
 	void Invalidate() noexcept;
 
 public:
+	SDLSurfaceSprite2D(const Region&, void* pixels, const PixelFormat& fmt, uint16_t pitch) noexcept;
 	SDLSurfaceSprite2D(const Region&, void* pixels, const PixelFormat& fmt) noexcept;
 	SDLSurfaceSprite2D(const Region&, const PixelFormat& fmt) noexcept;
 	SDLSurfaceSprite2D(const SDLSurfaceSprite2D &obj) noexcept;
@@ -86,16 +87,25 @@ class SDLTextureSprite2D : public SDLSurfaceSprite2D {
 	mutable SDL_Texture* texture = nullptr;
 	mutable bool staleTexture = false;
 
+	// set for frames that are part of a sprite sheet and can be drawn from its texture
+	Holder<const SDLTextureSprite2D> sheet;
+	Point sheetPos;
+
 	void OnSurfaceUpdate() const noexcept override;
 public:
 	SDLTextureSprite2D(const SDLTextureSprite2D&) noexcept;
 	SDLTextureSprite2D(const Region&, void* pixels, const PixelFormat& fmt) noexcept;
+	// a view of the frame at pos in sheet, sharing its pixels
+	SDLTextureSprite2D(const Region&, Holder<const SDLTextureSprite2D> sheet, const Point& pos) noexcept;
 	SDLTextureSprite2D(const Region&, const PixelFormat& fmt) noexcept;
 	~SDLTextureSprite2D() noexcept override;
 
 	Holder<Sprite2D> copy() const override;
 	
 	SDL_Texture* GetTexture(SDL_Renderer* renderer) const;
+	// the sheet to draw from instead of our own texture, if we still look the same
+	const SDLTextureSprite2D* GetSheet() const noexcept;
+	const Point& SheetPos() const noexcept { return sheetPos; }
 };
 #endif
 
@@ -86,7 +86,7 @@ int ZLibManager::Decompress(DataStream* dest, DataStream* source, unsigned int s
 	}
 }
 
-int ZLibManager::Compress(DataStream* dest, DataStream* source) const
+int ZLibManager::Compress(DataStream* dest, DataStream* source, int level) const
 {
 	unsigned char bufferin[INPUTSIZE];
 	unsigned char bufferout[OUTPUTSIZE];
@@ -96,7 +96,8 @@ int ZLibManager::Compress(DataStream* dest, DataStream* source) const
 	stream.zfree = Z_NULL;
 	stream.opaque = Z_NULL;
 
-	int result = deflateInit(&stream, Z_BEST_COMPRESSION);
+	level = Clamp(level, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
+	int result = deflateInit(&stream, level);
 	if (result != Z_OK) {
 		return GEM_ERROR;
 	}
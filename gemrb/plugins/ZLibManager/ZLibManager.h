@@ -31,7 +31,7 @@ public:
 	// ZLib Decompression Routine
 	int Decompress(DataStream* dest, DataStream* source, unsigned int size_guess) const override;
 	// ZLib Compression
-	int Compress(DataStream* dest, DataStream* source) const override;
+	int Compress(DataStream* dest, DataStream* source, int level) const override;
 };
 
 }
@@ -0,0 +1,121 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "GUI/TextSystem/TextContainer.h"
+
+namespace GemRB {
+
+// exposes the layout internals; plain Content needs no fonts
+class TestContainer : public ContentContainer {
+public:
+	TestContainer() : ContentContainer(Region(0, 0, 100, 0)) {}
+
+	const Content* FirstContentBelow(int y) const
+	{
+		ContentLayout::const_iterator it = FirstLayoutBelow(y + layoutOffset);
+		return it == layout.end() ? nullptr : it->content;
+	}
+
+	const LayoutRegion* FirstRegion(const Content* c) const
+	{
+		return LayoutForContent(c).regions.front().get();
+	}
+};
+
+static Content* AppendLine(TestContainer& container)
+{
+	Content* line = new Content(Size(100, 10));
+	container.AppendContent(line);
+	return line;
+}
+
+TEST(TextContainer_Test, AppendKeepsEarlierLayout) {
+	TestContainer container;
+	const Content* first = AppendLine(container);
+	const LayoutRegion* firstRegion = container.FirstRegion(first);
+
+	const Content* second = AppendLine(container);
+	const Content* third = AppendLine(container);
+	EXPECT_EQ(container.BoundingBoxForContent(second), Region(0, 10, 100, 10));
+	EXPECT_EQ(container.BoundingBoxForContent(third), Region(0, 20, 100, 10));
+	EXPECT_EQ(container.Frame().h, 30);
+
+	// appending only measures the new content
+	EXPECT_EQ(container.FirstRegion(first), firstRegion);
+}
+
+TEST(TextContainer_Test, FirstLayoutBelow) {
+	TestContainer container;
+	const Content* first = AppendLine(container);
+	const Content* second = AppendLine(container);
+	AppendLine(container);
+
+	EXPECT_EQ(container.FirstContentBelow(-5), first);
+	EXPECT_EQ(container.FirstContentBelow(9), first);
+	EXPECT_EQ(container.FirstContentBelow(10), second);
+	EXPECT_EQ(container.FirstContentBelow(15), second);
+	EXPECT_EQ(container.FirstContentBelow(30), nullptr);
+}
+
+TEST(TextContainer_Test, TrimmingKeepsRemainingLayout) {
+	TestContainer container;
+	AppendLine(container);
+	AppendLine(container);
+	const Content* third = AppendLine(container);
+	const Content* fourth = AppendLine(container);
+	const LayoutRegion* fourthRegion = container.FirstRegion(fourth);
+
+	container.DeleteContentsInRect(Region(0, 0, 100, 20));
+	EXPECT_EQ(container.Contents().size(), 2);
+	EXPECT_EQ(container.Frame().h, 20);
+	EXPECT_EQ(container.BoundingBoxForContent(third), Region(0, 0, 100, 10));
+	EXPECT_EQ(container.BoundingBoxForContent(fourth), Region(0, 10, 100, 10));
+	EXPECT_EQ(container.ContentAtPoint(Point(50, 5)), third);
+	EXPECT_EQ(container.FirstContentBelow(10), fourth);
+	// the remaining regions were neither measured nor moved again
+	EXPECT_EQ(container.FirstRegion(fourth), fourthRegion);
+
+	// appending after a trim continues below what is left
+	const Content* fifth = AppendLine(container);
+	EXPECT_EQ(container.BoundingBoxForContent(fifth), Region(0, 20, 100, 10));
+	EXPECT_EQ(container.Frame().h, 30);
+
+	container.DeleteContentsInRect(Region(0, 0, 100, 10));
+	EXPECT_EQ(container.BoundingBoxForContent(fourth), Region(0, 0, 100, 10));
+	EXPECT_EQ(container.BoundingBoxForContent(fifth), Region(0, 10, 100, 10));
+	EXPECT_EQ(container.ContentAtPoint(Point(50, 15)), fifth);
+	EXPECT_EQ(container.Frame().h, 20);
+}
+
+TEST(TextContainer_Test, TrimmingEverything) {
+	TestContainer container;
+	AppendLine(container);
+	AppendLine(container);
+
+	container.DeleteContentsInRect(Region(0, 0, 100, 20));
+	EXPECT_TRUE(container.Contents().empty());
+
+	const Content* line = AppendLine(container);
+	EXPECT_EQ(container.BoundingBoxForContent(line), Region(0, 0, 100, 10));
+	EXPECT_EQ(container.Frame().h, 10);
+}
+
+}
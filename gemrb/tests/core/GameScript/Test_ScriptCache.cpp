@@ -0,0 +1,104 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "GameScript/GameScript.h"
+#include "GameScript/ScriptCache.h"
+
+namespace GemRB {
+
+static void FillScript(Script& script)
+{
+	ResponseBlock* block = new ResponseBlock();
+	block->condition = new Condition();
+	Trigger* trigger = new Trigger();
+	trigger->triggerID = 42;
+	trigger->int0Parameter = -7;
+	trigger->string0Parameter = "GLOBALsomevar";
+	trigger->objectParameter = new Object();
+	trigger->objectParameter->objectFields[0] = 3;
+	trigger->objectParameter->objectRect = Region(1, 2, 3, 4);
+	block->condition->triggers.push_back(trigger);
+
+	block->responseSet = new ResponseSet();
+	Response* response = new Response();
+	response->weight = 100;
+	Action* action = new Action(false);
+	action->actionID = 7;
+	action->pointParameter = Point(10, 20);
+	action->string1Parameter = "ar0602";
+	action->flags = ACF_PRECOMPILED;
+	response->actions.push_back(action);
+	block->responseSet->responses.push_back(response);
+
+	script.responseBlocks.push_back(block);
+}
+
+// keep the images out of the working directory and clean up even after failed asserts
+class ScriptCache_Test : public testing::Test {
+protected:
+	path_t IMAGE_FILE = PathJoin(testing::TempDir(), "scriptcache_test.bcsc");
+
+	void TearDown() override
+	{
+		UnlinkFile(IMAGE_FILE);
+	}
+};
+
+TEST_F(ScriptCache_Test, RoundTrip) {
+	Script original;
+	FillScript(original);
+	ASSERT_TRUE(SaveCompiledScript(IMAGE_FILE, 0x1234, original));
+
+	Script loaded;
+	ASSERT_TRUE(LoadCompiledScript(IMAGE_FILE, 0x1234, loaded));
+	ASSERT_EQ(loaded.responseBlocks.size(), 1);
+	EXPECT_EQ(ScriptFootprint(loaded), ScriptFootprint(original));
+
+	const Trigger* trigger = loaded.responseBlocks[0]->condition->triggers[0];
+	EXPECT_EQ(trigger->triggerID, 42);
+	EXPECT_EQ(trigger->int0Parameter, -7);
+	EXPECT_EQ(trigger->string0Parameter, "GLOBALsomevar");
+	ASSERT_NE(trigger->objectParameter, nullptr);
+	EXPECT_EQ(trigger->objectParameter->objectFields[0], 3);
+	EXPECT_EQ(trigger->objectParameter->objectRect, Region(1, 2, 3, 4));
+
+	const Response* response = loaded.responseBlocks[0]->responseSet->responses[0];
+	EXPECT_EQ(response->weight, 100);
+	const Action* action = response->actions[0];
+	EXPECT_EQ(action->actionID, 7);
+	EXPECT_EQ(action->pointParameter, Point(10, 20));
+	EXPECT_EQ(action->string1Parameter, "ar0602");
+	EXPECT_EQ(action->flags, ACF_PRECOMPILED);
+	EXPECT_EQ(action->objects[0], nullptr);
+}
+
+TEST_F(ScriptCache_Test, RejectsStaleImage) {
+	Script original;
+	FillScript(original);
+	ASSERT_TRUE(SaveCompiledScript(IMAGE_FILE, 0x1234, original));
+
+	Script loaded;
+	EXPECT_FALSE(LoadCompiledScript(IMAGE_FILE, 0x4321, loaded));
+	EXPECT_TRUE(loaded.responseBlocks.empty());
+	EXPECT_FALSE(LoadCompiledScript(PathJoin(testing::TempDir(), "scriptcache_missing.bcsc"), 0x1234, loaded));
+}
+
+}
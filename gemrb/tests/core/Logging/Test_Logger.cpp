@@ -0,0 +1,73 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "Logging/Logger.h"
+
+#include <vector>
+
+namespace GemRB {
+
+class CollectingWriter : public Logger::LogWriter {
+public:
+	std::vector<std::string> messages;
+
+	CollectingWriter() : Logger::LogWriter(DEBUG) {}
+
+	void WriteLogMessage(const Logger::LogMessage& msg) override
+	{
+		messages.push_back(msg.message);
+	}
+};
+
+TEST(Logger_Test, DeliversInOrder) {
+	auto writer = std::make_shared<CollectingWriter>();
+	{
+		Logger logger({});
+		logger.AddLogWriter(writer);
+		for (int i = 0; i < 100; ++i) {
+			logger.LogMsg(MESSAGE, "Test", std::to_string(i).c_str(), Logger::MSG_STYLE);
+		}
+		// the destructor processes what is left
+	}
+
+	ASSERT_EQ(writer->messages.size(), 100);
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_EQ(writer->messages[i], std::to_string(i));
+	}
+}
+
+TEST(Logger_Test, DropsWhenFull) {
+	auto writer = std::make_shared<CollectingWriter>();
+	{
+		Logger logger({});
+		// nothing consumes the queue before the first writer is added
+		for (size_t i = 0; i < Logger::QueueSize + 10; ++i) {
+			logger.LogMsg(MESSAGE, "Test", "backlog", Logger::MSG_STYLE);
+		}
+		logger.AddLogWriter(writer);
+	}
+
+	ASSERT_EQ(writer->messages.size(), Logger::QueueSize + 1);
+	EXPECT_EQ(writer->messages.front(), "backlog");
+	EXPECT_NE(writer->messages.back().find("Dropped 10 messages"), std::string::npos);
+}
+
+}
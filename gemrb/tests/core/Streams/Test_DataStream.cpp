@@ -201,6 +201,27 @@ TEST(DataStream_WritingTest, Writes) {
 	}
 }
 
+TEST(DataStream_WritingTest, Appends) {
+	MemoryStream stream{"", nullptr, 0};
+
+	for (uint16_t i = 0; i < 1000; ++i) {
+		EXPECT_EQ(stream.WriteScalar(i), 2);
+	}
+	EXPECT_EQ(stream.Size(), 2000);
+
+	// overwriting in the middle must not change the size
+	stream.Seek(10, GEM_STREAM_START);
+	EXPECT_EQ(stream.WriteScalar(uint16_t{0xFFFF}), 2);
+	EXPECT_EQ(stream.Size(), 2000);
+
+	stream.Rewind();
+	for (uint16_t i = 0; i < 1000; ++i) {
+		uint16_t v = 0;
+		stream.ReadScalar(v);
+		EXPECT_EQ(v, i == 5 ? 0xFFFF : i);
+	}
+}
+
 static DataStream* createFileStream(const path_t& path) {
 	auto fstream = new FileStream();
 	fstream->Open(path);
@@ -153,6 +153,41 @@ TEST(VFS_Test, ResolveCase) {
 #endif
 }
 
+TEST(VFS_Test, ResolveCase_ASCII) {
+	auto badPath = PathJoin<false>("tests", "resoUrces", "vfs", "encoding", "FILE.TXT");
+	const auto& path = ResolveCase(badPath);
+#if IS_CASE_INSENSITIVE
+	EXPECT_EQ(path, fmt::format("tests{0}resoUrces{0}vfs{0}encoding{0}FILE.TXT", SPathDelimiter));
+#else
+	EXPECT_EQ(path, "tests/resources/VFS/encoding/file.txt");
+#endif
+}
+
+TEST(VFS_Test, ResolveCase_NewFile) {
+	auto tempPath = getTempPath();
+	auto dirPath = PathJoin(tempPath, "resolve_case");
+	ASSERT_TRUE(MakeDirectory(dirPath));
+
+	// the first lookup fails, so any directory listing is taken before the file exists
+	auto path = PathJoin<false>(dirPath, "NEW.TXT");
+	EXPECT_EQ(ResolveCase(path), PathJoin<false>(dirPath, "NEW.TXT"));
+
+	auto filePath = PathJoin<false>(dirPath, "New.txt");
+	{
+		FileT file;
+		file.OpenNew(filePath);
+	}
+	path = PathJoin<false>(dirPath, "NEW.TXT");
+#if IS_CASE_INSENSITIVE
+	EXPECT_TRUE(FileExists(path));
+#else
+	EXPECT_EQ(ResolveCase(path), filePath);
+#endif
+
+	UnlinkFile(filePath);
+	RemoveDirectory(dirPath);
+}
+
 TEST(VFS_Test, MakeDirectory) {
 	auto tempPath = getTempPath();
 
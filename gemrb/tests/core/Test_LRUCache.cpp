@@ -0,0 +1,120 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2024 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/LRUCache.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+struct TestEntry {
+	size_t bytes;
+	bool busy;
+
+	TestEntry(size_t bytes, bool busy = false) : bytes(bytes), busy(busy) {}
+	void evictionNotice() const {}
+};
+
+struct TestEntryIdle {
+	bool operator()(const TestEntry& entry) const { return !entry.busy; }
+};
+
+struct TestEntryBytes {
+	size_t operator()(const TestEntry& entry) const { return entry.bytes; }
+};
+
+TEST(LRUCache_Test, EvictsByCount)
+{
+	LRUCache<TestEntry, TestEntryIdle> cache(2);
+	cache.SetAt("a", 1);
+	cache.SetAt("b", 1);
+	cache.SetAt("c", 1);
+
+	EXPECT_EQ(cache.Lookup("a"), nullptr);
+	EXPECT_NE(cache.Lookup("b"), nullptr);
+	EXPECT_NE(cache.Lookup("c"), nullptr);
+}
+
+TEST(LRUCache_Test, EvictsByBudget)
+{
+	LRUCache<TestEntry, TestEntryIdle, TestEntryBytes> cache(100, 10);
+	cache.SetAt("a", 4);
+	cache.SetAt("b", 4);
+	EXPECT_EQ(cache.Usage(), 8);
+
+	// needs both older entries gone
+	cache.SetAt("c", 9);
+	EXPECT_EQ(cache.Lookup("a"), nullptr);
+	EXPECT_EQ(cache.Lookup("b"), nullptr);
+	EXPECT_NE(cache.Lookup("c"), nullptr);
+	EXPECT_EQ(cache.Usage(), 9);
+
+	EXPECT_TRUE(cache.Remove("c"));
+	EXPECT_EQ(cache.Usage(), 0);
+}
+
+TEST(LRUCache_Test, KeepsBusyEntriesOverBudget)
+{
+	LRUCache<TestEntry, TestEntryIdle, TestEntryBytes> cache(100, 10);
+	cache.SetAt("a", 6, true);
+	cache.SetAt("b", 6);
+
+	EXPECT_NE(cache.Lookup("a"), nullptr);
+	EXPECT_NE(cache.Lookup("b"), nullptr);
+	EXPECT_EQ(cache.Usage(), 12);
+
+	// b is idle, so it goes first
+	cache.SetAt("c", 2);
+	EXPECT_NE(cache.Lookup("a"), nullptr);
+	EXPECT_EQ(cache.Lookup("b"), nullptr);
+	EXPECT_EQ(cache.Usage(), 8);
+}
+
+TEST(LRUCache_Test, KeepsResidentEntry)
+{
+	LRUCache<TestEntry, TestEntryIdle, TestEntryBytes> cache(100, 10);
+	const TestEntry* first = cache.SetAt("a", 4);
+	ASSERT_NE(first, nullptr);
+
+	// a second insertion of the same key hands back the first entry
+	const TestEntry* second = cache.SetAt("a", 6);
+	EXPECT_EQ(second, first);
+	EXPECT_EQ(second->bytes, 4);
+	EXPECT_EQ(cache.Usage(), 4);
+}
+
+TEST(LRUCache_Test, Clear)
+{
+	LRUCache<TestEntry, TestEntryIdle, TestEntryBytes> cache(100, 10);
+	cache.SetAt("a", 4);
+	cache.SetAt("b", 4);
+
+	cache.Clear();
+	EXPECT_EQ(cache.Lookup("a"), nullptr);
+	EXPECT_EQ(cache.Lookup("b"), nullptr);
+	EXPECT_EQ(cache.Usage(), 0);
+
+	// still usable afterwards
+	cache.SetAt("c", 2);
+	EXPECT_NE(cache.Lookup("c"), nullptr);
+	EXPECT_TRUE(cache.Touch("c"));
+	EXPECT_EQ(cache.Usage(), 2);
+}
+
+}
@@ -0,0 +1,58 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "Profiler.h"
+
+namespace GemRB {
+
+TEST(Profiler_Test, AveragesPerFrame) {
+	Profiler::Enable(true);
+	for (int frame = 0; frame < 2; ++frame) {
+		Profiler::AddTime(ProfileZone::Scripts, 3000000);
+		Profiler::Count(ProfileCounter::DrawCalls, 10);
+		Profiler::EndFrame();
+	}
+
+	std::string report = Profiler::Report();
+	EXPECT_NE(report.find("Scripts: 3.00ms"), std::string::npos);
+	EXPECT_NE(report.find("Draw calls: 10"), std::string::npos);
+	EXPECT_NE(report.find("Effects: 0.00ms"), std::string::npos);
+
+	// everything was consumed by the report
+	EXPECT_NE(Profiler::Report().find("Scripts: 0.00ms"), std::string::npos);
+	Profiler::Enable(false);
+}
+
+TEST(Profiler_Test, DisabledIgnoresCounters) {
+	Profiler::Enable(false);
+	Profiler::Count(ProfileCounter::ResourceLoads, 5);
+	{
+		ProfileScope scope(ProfileZone::Fog);
+	}
+	Profiler::Enable(true);
+	Profiler::EndFrame();
+	std::string report = Profiler::Report();
+	EXPECT_NE(report.find("Resource loads: 0"), std::string::npos);
+	EXPECT_NE(report.find("Fog: 0.00ms"), std::string::npos);
+	Profiler::Enable(false);
+}
+
+}
@@ -0,0 +1,72 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2024 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "WorldMap.h"
+
+namespace GemRB {
+
+static WMPAreaEntry MakeEntry(const ResRef& name, const ResRef& resRef, ieDword iconSeq)
+{
+	WMPAreaEntry ae;
+	ae.AreaName = name;
+	ae.AreaResRef = resRef;
+	ae.IconSeq = iconSeq;
+	return ae;
+}
+
+TEST(WorldMap_Test, GetArea) {
+	WorldMap map;
+	map.AddAreaEntry(MakeEntry("AR0100", "AR0100", 1));
+	map.AddAreaEntry(MakeEntry("AR0200", "AR0201", 2));
+	map.AddAreaEntry(MakeEntry("AR0100", "AR0101", 3));
+
+	const WorldMap& cmap = map;
+	size_t idx;
+	const WMPAreaEntry* ae = cmap.GetArea("ar0100", idx);
+	ASSERT_NE(ae, nullptr);
+	// the last entry with the name wins, like with the old backwards scan
+	EXPECT_EQ(idx, 2);
+	EXPECT_EQ(ae->IconSeq, 3);
+
+	// the original name is only a fallback
+	ae = cmap.GetArea("AR0201", idx);
+	ASSERT_NE(ae, nullptr);
+	EXPECT_EQ(idx, 1);
+
+	EXPECT_EQ(cmap.GetArea("AR0300"), nullptr);
+}
+
+TEST(WorldMap_Test, SetAreaEntryUpdatesLookup) {
+	WorldMap map;
+	map.SetAreaEntry(0, MakeEntry("AR0100", "AR0100", 1));
+	map.SetAreaEntry(1, MakeEntry("AR0200", "AR0200", 2));
+	map.SetAreaEntry(0, MakeEntry("AR0300", "AR0300", 3));
+
+	const WorldMap& cmap = map;
+	EXPECT_EQ(cmap.GetArea("AR0100"), nullptr);
+	size_t idx;
+	ASSERT_NE(cmap.GetArea("AR0300", idx), nullptr);
+	EXPECT_EQ(idx, 0);
+	ASSERT_NE(cmap.GetArea("AR0200", idx), nullptr);
+	EXPECT_EQ(idx, 1);
+}
+
+}